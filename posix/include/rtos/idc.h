@@ -34,6 +34,9 @@
 /** \brief IDC send core power down flag. */
 #define IDC_POWER_DOWN		3
 
+/** \brief IDC send flag, completion is collected with idc_wait_msg(). */
+#define IDC_ASYNC		4
+
 /** \brief IDC send timeout in microseconds. */
 #define IDC_TIMEOUT	10000
 
@@ -320,6 +320,9 @@ static int asrc_free(struct processing_module *mod)
 
 	comp_info(dev, "asrc_free()");
 
+	if (cd->drift)
+		asrc_drift_put(cd->drift, cd);
+
 	rfree(cd->buf);
 	asrc_release_buffers(cd->asrc_obj);
 	rfree(cd->asrc_obj);
@@ -509,10 +512,27 @@ static int asrc_trigger(struct processing_module *mod, int cmd)
 			return ret;
 		}
 
+		/* The drift estimate is shared with other ASRC instances
+		 * those track the same DAI. Holding a reference to it is
+		 * what allows to stop the DAI timestamps in reset.
+		 */
+		if (!cd->drift) {
+			cd->drift = asrc_drift_get(cd->dai_dev, cd->skew);
+			if (!cd->drift) {
+				comp_err(dev, "Failed drift estimator allocation");
+				cd->track_drift = false;
+				return -ENOMEM;
+			}
+		}
+
 		cd->ts_count = 0;
 		ret = asrc_dai_configure_timestamp(cd);
 		if (ret) {
 			comp_err(dev, "No timestamp capability in DAI");
+			if (asrc_drift_put(cd->drift, cd))
+				asrc_dai_stop_timestamp(cd);
+
+			cd->drift = NULL;
 			cd->track_drift = false;
 			return ret;
 		}
@@ -708,62 +728,41 @@ static int asrc_control_loop(struct comp_dev *dev, struct comp_data *cd)
 #else
 	struct timestamp_data tsd;
 #endif
-	int64_t tmp;
-	int32_t delta_sample;
-	int32_t delta_ts;
-	int32_t sample;
-	int32_t ts;
-	int32_t skew;
-	int32_t f_ds_dt;
-	int32_t f_ck_fs;
-	int ts_ret;
+	int ret;
 
 	if (!cd->track_drift)
 		return 0;
 
-	if (!cd->ts_count) {
-		cd->ts_count++;
-		asrc_dai_start_timestamp(cd);
-		return 0;
-	}
-
-	ts_ret = asrc_dai_get_timestamp(cd, &tsd);
-	asrc_dai_start_timestamp(cd);
-	if (ts_ret)
-		return ts_ret;
+	/* Only one of the ASRC instances those track the DAI reads the
+	 * timestamps and updates the drift estimate.
+	 */
+	if (asrc_drift_is_owner(cd->drift, cd)) {
+		if (!cd->ts_count) {
+			cd->ts_count++;
+			asrc_dai_start_timestamp(cd);
+			return 0;
+		}
 
-	ts = (int32_t)(tsd.walclk); /* Let it wrap, diff unwraps */
-	sample = (int32_t)(tsd.sample); /* Let it wrap, diff unwraps */
-	delta_ts = ts - cd->ts_prev;
-	delta_sample = sample - cd->sample_prev;
-	cd->ts_prev = ts;
-	cd->sample_prev = sample;
+		ret = asrc_dai_get_timestamp(cd, &tsd);
+		asrc_dai_start_timestamp(cd);
+		if (ret)
+			return ret;
 
-	/* Avoid first delta timestamp(s) those can be off and
-	 * confuse the filter.
-	 */
-	if (cd->ts_count < TS_STABLE_DIFF_COUNT) {
-		cd->ts_count++;
-		return 0;
-	}
+		ret = asrc_drift_update(cd->drift, (int32_t)tsd.walclk, (int32_t)tsd.sample,
+					tsd.walclk_rate, cd->asrc_obj->fs_sec);
+		if (ret < 0) {
+			comp_err(dev, "asrc_control_loop(), DAI timestamp failed");
+			return ret;
+		}
 
-	/* Prevent divide by zero */
-	if (delta_sample == 0 || tsd.walclk_rate == 0) {
-		comp_err(dev, "asrc_control_loop(), DAI timestamp failed");
-		return -EINVAL;
+		if (ret > 0)
+			return 0;
 	}
 
-	/* fraction f_ds_dt is Q20.12
-	 * fraction f_cd_fs is Q1.31
-	 * drift needs to be Q2.30
-	 */
-	f_ds_dt = (delta_ts << 12) / delta_sample;
-	f_ck_fs = ((int64_t)cd->asrc_obj->fs_sec << 31) / tsd.walclk_rate;
-	skew = q_multsr_sat_32x32(f_ds_dt, f_ck_fs, 13);
+	if (cd->drift->skew == cd->skew)
+		return 0;
 
-	/* tmp is Q4.60, shift and round to Q2.30 */
-	tmp = ((int64_t)COEF_C1) * skew + ((int64_t)COEF_C2) * cd->skew;
-	cd->skew = sat_int32(Q_SHIFT_RND(tmp, 60, 30));
+	cd->skew = cd->drift->skew;
 	asrc_update_drift(dev, cd->asrc_obj, cd->skew);
 
 	/* Track skew variation, it helps to analyze possible problems
@@ -771,7 +770,7 @@ static int asrc_control_loop(struct comp_dev *dev, struct comp_data *cd)
 	 */
 	cd->skew_min = MIN(cd->skew, cd->skew_min);
 	cd->skew_max = MAX(cd->skew, cd->skew_max);
-	comp_dbg(dev, "skew %d %d %d %d", delta_sample, delta_ts, skew, cd->skew);
+	comp_dbg(dev, "skew %d", cd->skew);
 	return 0;
 }
 
@@ -853,9 +852,16 @@ static int asrc_reset(struct processing_module *mod)
 	comp_info(dev, "asrc_reset(), skew_min=%d, skew_max=%d", cd->skew_min, cd->skew_max);
 
 
-	/* If any resources feasible to stop */
-	if (cd->track_drift)
-		asrc_dai_stop_timestamp(cd);
+	/* If any resources feasible to stop. The timestamps are stopped
+	 * when the last ASRC instance that holds the estimator of the DAI
+	 * is reset. An instance that was never started holds none.
+	 */
+	if (cd->drift) {
+		if (asrc_drift_put(cd->drift, cd))
+			asrc_dai_stop_timestamp(cd);
+
+		cd->drift = NULL;
+	}
 
 	/* Free the allocations those were done in prepare() */
 	asrc_release_buffers(cd->asrc_obj);
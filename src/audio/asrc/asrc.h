@@ -9,6 +9,7 @@
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/audio/audio_stream.h>
 #include <sof/audio/component.h>
+#include "asrc_drift.h"
 #include "asrc_farrow.h"
 
 struct comp_data;
@@ -69,18 +70,6 @@ int asrc_dai_get_timestamp(struct comp_data *cd, struct dai_ts_data *tsd);
 #else
 int asrc_dai_get_timestamp(struct comp_data *cd, struct timestamp_data *tsd);
 #endif
-/* Simple count value to prevent first delta timestamp
- * from being input to low-pass filter.
- */
-#define TS_STABLE_DIFF_COUNT	2
-
-/* Low pass filter coefficient for measured drift factor,
- * The low pass function is y(n) = c1 * x(n) + c2 * y(n -1)
- * coefficient c2 needs to be 1 - c1.
- */
-#define COEF_C1		Q_CONVERT_FLOAT(0.01, 30)
-#define COEF_C2		Q_CONVERT_FLOAT(0.99, 30)
-
 typedef void (*asrc_proc_func)(struct processing_module *mod,
 			       const struct audio_stream *source,
 			       struct audio_stream *sink,
@@ -91,6 +80,7 @@ struct comp_data {
 	ipc_asrc_cfg ipc_config;
 	struct asrc_farrow *asrc_obj;	/* ASRC core data */
 	struct comp_dev *dai_dev;	/* Associated DAI component */
+	struct asrc_drift *drift;	/* Drift estimator of the DAI */
 	enum asrc_operation_mode mode;  /* Control for push or pull mode */
 	uint64_t ts;
 	uint32_t sink_rate;	/* Sample rate in Hz */
@@ -98,8 +88,6 @@ struct comp_data {
 	uint32_t sink_format;	/* For used PCM sample format */
 	uint32_t source_format;	/* For used PCM sample format */
 	uint32_t copy_count;	/* Count copy() operations  */
-	int32_t ts_prev;
-	int32_t sample_prev;
 	int32_t skew;		/* Rate factor in Q2.30 */
 	int32_t skew_min;
 	int32_t skew_max;
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/list.h>
+#include <sof/lib/memory.h>
+#include <rtos/alloc.h>
+#include <rtos/spinlock.h>
+#include <ipc/topology.h>
+#include <errno.h>
+#include <stdint.h>
+#include "asrc_drift.h"
+
+/* Simple count value to prevent first delta timestamp
+ * from being input to the loop filter.
+ */
+#define ASRC_DRIFT_STABLE_COUNT		2
+
+/* The skew is tracked with a second order loop. The proportional term
+ * follows the measured skew with gain 2^-ASRC_DRIFT_KP_SHIFT. The integral
+ * term corrects the accumulated skew error with gain 2^-ASRC_DRIFT_KI_SHIFT.
+ * In the accumulated error the timestamp jitter of consecutive measurements
+ * cancels out, so the loop settles without a remaining phase error and with
+ * less jitter in the skew than with first order low-pass filtering. The
+ * gains give a nearly critically damped loop with time constant of about
+ * 60 updates.
+ */
+#define ASRC_DRIFT_KP_SHIFT		5
+#define ASRC_DRIFT_KI_SHIFT		12
+
+/* The ASRC instances those share an estimator can run on different cores.
+ * The list is accessed only through its uncached alias and under the lock,
+ * the estimators are allocated from shared memory.
+ */
+struct asrc_drift_list {
+	struct k_spinlock lock;
+	struct list_item head;		/* Initialized on first use */
+};
+
+static SHARED_DATA struct asrc_drift_list drift_list_shared;
+
+static struct asrc_drift_list *asrc_drift_list_get(void)
+{
+	return cache_to_uncache(&drift_list_shared);
+}
+
+struct asrc_drift *asrc_drift_get(const struct comp_dev *dai_dev, int32_t skew)
+{
+	struct asrc_drift_list *list = asrc_drift_list_get();
+	struct asrc_drift *new_drift;
+	struct asrc_drift *drift;
+	struct list_item *item;
+	k_spinlock_key_t key;
+
+	/* Allocate before taking the lock, it is freed if the DAI
+	 * already has an estimator.
+	 */
+	new_drift = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, 0, SOF_MEM_CAPS_RAM,
+			    sizeof(*new_drift));
+
+	key = k_spin_lock(&list->lock);
+	if (!list->head.next)
+		list_init(&list->head);
+
+	list_for_item(item, &list->head) {
+		drift = list_item(item, struct asrc_drift, item);
+		if (drift->dai_dev == dai_dev) {
+			drift->ref_count++;
+			k_spin_unlock(&list->lock, key);
+			rfree(new_drift);
+			return drift;
+		}
+	}
+
+	if (new_drift) {
+		new_drift->dai_dev = dai_dev;
+		new_drift->skew = skew;
+		new_drift->ref_count = 1;
+		list_item_append(&new_drift->item, &list->head);
+	}
+
+	k_spin_unlock(&list->lock, key);
+	return new_drift;
+}
+
+bool asrc_drift_put(struct asrc_drift *drift, const void *user)
+{
+	struct asrc_drift_list *list = asrc_drift_list_get();
+	k_spinlock_key_t key;
+	bool last;
+
+	key = k_spin_lock(&list->lock);
+
+	/* Let another user feed the timestamps */
+	if (drift->owner == user)
+		drift->owner = NULL;
+
+	drift->ref_count--;
+	last = !drift->ref_count;
+	if (last)
+		list_item_del(&drift->item);
+
+	k_spin_unlock(&list->lock, key);
+
+	if (last)
+		rfree(drift);
+
+	return last;
+}
+
+bool asrc_drift_is_owner(struct asrc_drift *drift, const void *user)
+{
+	struct asrc_drift_list *list = asrc_drift_list_get();
+	k_spinlock_key_t key;
+	bool owner;
+
+	/* The owner changes only when a user releases the estimator */
+	if (drift->owner)
+		return drift->owner == user;
+
+	key = k_spin_lock(&list->lock);
+	if (!drift->owner) {
+		drift->owner = user;
+		drift->ts_count = 0;
+	}
+
+	owner = drift->owner == user;
+	k_spin_unlock(&list->lock, key);
+	return owner;
+}
+
+int asrc_drift_update(struct asrc_drift *drift, int32_t ts, int32_t sample,
+		      uint32_t walclk_rate, int32_t fs)
+{
+	int32_t delta_sample;
+	int32_t delta_ts;
+	int32_t skew;
+	int32_t f_ds_dt;
+	int32_t f_ck_fs;
+	int32_t err;
+	int64_t tmp;
+
+	delta_ts = ts - drift->ts_prev; /* Let it wrap, diff unwraps */
+	delta_sample = sample - drift->sample_prev;
+	drift->ts_prev = ts;
+	drift->sample_prev = sample;
+
+	/* Avoid first delta timestamp(s) those can be off and
+	 * confuse the filter.
+	 */
+	if (drift->ts_count < ASRC_DRIFT_STABLE_COUNT) {
+		drift->ts_count++;
+		return 1;
+	}
+
+	/* Prevent divide by zero */
+	if (delta_sample <= 0 || walclk_rate == 0)
+		return -EINVAL;
+
+	/* fraction f_ds_dt is Q20.12
+	 * fraction f_cd_fs is Q1.31
+	 * measured skew is Q2.30
+	 */
+	f_ds_dt = (delta_ts << 12) / delta_sample;
+	f_ck_fs = ((int64_t)fs << 31) / walclk_rate;
+	skew = q_multsr_sat_32x32(f_ds_dt, f_ck_fs, 13);
+
+	/* Accumulate the error of filtered skew vs. measured skew over the
+	 * samples of the interval, then update with proportional and integral
+	 * terms. The integral term is normalized with the interval length.
+	 */
+	err = skew - drift->skew;
+	drift->phase += (int64_t)err * delta_sample;
+	tmp = (int64_t)drift->skew + (err >> ASRC_DRIFT_KP_SHIFT) +
+		((drift->phase / delta_sample) >> ASRC_DRIFT_KI_SHIFT);
+	drift->skew = sat_int32(tmp);
+	return 0;
+}
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2024 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_AUDIO_ASRC_ASRC_DRIFT_H__
+#define __SOF_AUDIO_ASRC_ASRC_DRIFT_H__
+
+#include <sof/list.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+struct comp_dev;
+
+/* Drift estimate for a DAI, shared by all ASRC instances those track the
+ * same DAI. One of the instances, the owner, feeds the DAI timestamps to
+ * the estimator and all of them apply the published skew.
+ */
+struct asrc_drift {
+	struct list_item item;
+	const struct comp_dev *dai_dev;	/* Tracked DAI */
+	const void *owner;		/* Instance that feeds timestamps */
+	int64_t phase;			/* Accumulated skew error, Q2.30 x samples */
+	int32_t skew;			/* Filtered rate factor in Q2.30 */
+	int32_t ts_prev;
+	int32_t sample_prev;
+	int ts_count;
+	uint32_t ref_count;
+};
+
+/**
+ * \brief Get the drift estimator for a DAI, a new one is created if there is
+ *	  no estimator for the DAI yet.
+ * \param[in] dai_dev	DAI component to track.
+ * \param[in] skew	Initial rate factor in Q2.30 for a new estimator.
+ * \return Pointer to estimator, NULL if allocation failed.
+ */
+struct asrc_drift *asrc_drift_get(const struct comp_dev *dai_dev, int32_t skew);
+
+/**
+ * \brief Release the drift estimator of an ASRC instance.
+ * \param[in] drift	Estimator from asrc_drift_get().
+ * \param[in] user	ASRC instance that releases the estimator.
+ * \return True if this was the last user of the estimator, the DAI
+ *	   timestamping should then be stopped.
+ */
+bool asrc_drift_put(struct asrc_drift *drift, const void *user);
+
+/**
+ * \brief Claim feeding of timestamps to the estimator if it has no owner.
+ * \param[in] drift	Estimator from asrc_drift_get().
+ * \param[in] user	ASRC instance.
+ * \return True if the instance is the owner and should call asrc_drift_update().
+ */
+bool asrc_drift_is_owner(struct asrc_drift *drift, const void *user);
+
+/**
+ * \brief Update the drift estimate with a DAI timestamp.
+ * \param[in] drift		Estimator from asrc_drift_get().
+ * \param[in] ts		Wall clock value of timestamp, may wrap.
+ * \param[in] sample		Sample count value of timestamp, may wrap.
+ * \param[in] walclk_rate	Wall clock rate in Hz.
+ * \param[in] fs		Nominal sample rate in Hz of the DAI side.
+ * \return Zero if the skew was updated, positive value if the timestamps
+ *	   are not yet stable, or negative error code.
+ */
+int asrc_drift_update(struct asrc_drift *drift, int32_t ts, int32_t sample,
+		      uint32_t walclk_rate, int32_t fs);
+
+#endif /* __SOF_AUDIO_ASRC_ASRC_DRIFT_H__ */
@@ -11,14 +11,44 @@
 
 LOG_MODULE_DECLARE(asrc, CONFIG_SOF_LOG_LEVEL);
 
+/* The impulse response is the same for all channels. The filters process
+ * channels in pairs so that each coefficient is loaded once for two
+ * channels, a possible odd channel is filtered alone.
+ */
+static inline int64_t asrc_fir_mac16(const int32_t *filter_p, const int16_t *buffer_p,
+				     int length)
+{
+	int64_t prod = 0;
+	int n;
+
+	for (n = 0; n < length; n++)
+		prod += (int64_t)(*buffer_p--) * (*filter_p++);
+
+	return prod;
+}
+
+static inline int16_t asrc_fir_round16(int64_t prod)
+{
+	/* Shift left after accumulation, because interim
+	 * results might saturate during filtering prod = prod
+	 * << 1; will shift after last addition
+	 */
+	int32_t prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
+
+	/* Round 'prod' to 16 bit */
+	return sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+}
+
 void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
-	int32_t prod32;
-	int16_t prod16;
+	int64_t prod0;
+	int64_t prod1;
+	int32_t coef;
 	int32_t *filter_p;
-	int16_t *buffer_p;
+	int16_t *buffer0_p;
+	int16_t *buffer1_p;
+	int pos = src_obj->buffer_write_position;
 	int ch;
 	int n;
 	int i;
@@ -28,45 +58,59 @@ void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/* Pointer to the beginning of the impulse response */
+	/* Iterate over channel pairs */
+	for (ch = 0; ch + 1 < src_obj->num_channels; ch += 2) {
 		filter_p = &src_obj->impulse_response[0];
-
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers16[ch]
-			[src_obj->buffer_write_position];
-
-		/* Initialise the accumulator */
-		prod = 0;
+		buffer0_p = &src_obj->ring_buffers16[ch][pos];
+		buffer1_p = &src_obj->ring_buffers16[ch + 1][pos];
+		prod0 = 0;
+		prod1 = 0;
 
 		/* Iterate over the filter bins.
 		 * Data is Q1.15, coefficients are Q1.30. Prod will be Qx.45.
 		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p--) * (*filter_p++);
-
-		/* Shift left after accumulation, because interim
-		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
-		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
+		for (n = 0; n < src_obj->filter_length; n++) {
+			coef = *filter_p++;
+			prod0 += (int64_t)(*buffer0_p--) * coef;
+			prod1 += (int64_t)(*buffer1_p--) * coef;
+		}
+
+		/* Store in (de-)interleaved format in the output buffers */
+		output_buffers[ch][i] = asrc_fir_round16(prod0);
+		output_buffers[ch + 1][i] = asrc_fir_round16(prod1);
+	}
 
-		/* Round 'prod' to 16 bit and store it in
-		 * (de-)interleaved format in the output buffers
-		 */
-		prod16 = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
-		output_buffers[ch][i] = prod16;
+	/* The last channel if odd count */
+	if (ch < src_obj->num_channels) {
+		prod0 = asrc_fir_mac16(&src_obj->impulse_response[0],
+				       &src_obj->ring_buffers16[ch][pos],
+				       src_obj->filter_length);
+		output_buffers[ch][i] = asrc_fir_round16(prod0);
 	}
 }
 
+static inline int64_t asrc_fir_mac32(const int32_t *filter_p, const int32_t *buffer_p,
+				     int length)
+{
+	int64_t prod = 0;
+	int n;
+
+	for (n = 0; n < length; n++)
+		prod += (int64_t)(*buffer_p--) * (*filter_p++ >> 8);
+
+	return prod;
+}
+
 void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
-	int32_t prod32;
+	int64_t prod0;
+	int64_t prod1;
+	int32_t coef;
 	const int32_t *filter_p;
-	int32_t *buffer_p;
+	int32_t *buffer0_p;
+	int32_t *buffer1_p;
+	int pos = src_obj->buffer_write_position;
 	int ch;
 	int n;
 	int i;
@@ -76,17 +120,13 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/* Pointer to the beginning of the impulse response */
+	/* Iterate over channel pairs */
+	for (ch = 0; ch + 1 < src_obj->num_channels; ch += 2) {
 		filter_p = &src_obj->impulse_response[0];
-
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers32[ch]
-			[src_obj->buffer_write_position];
-
-		/* Initialise the accumulator */
-		prod = 0;
+		buffer0_p = &src_obj->ring_buffers32[ch][pos];
+		buffer1_p = &src_obj->ring_buffers32[ch + 1][pos];
+		prod0 = 0;
+		prod1 = 0;
 
 		/* Iterate over the filter bins. Data is Q1.31, coefficients
 		 * are Q1.22. They are down scaled by 1 shift. In addition
@@ -95,19 +135,27 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		 * of 24 bits of 32 bits is not a practical limitation for
 		 * quality. The product is Qx.54.
 		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p--) * (*filter_p++ >> 8);
+		for (n = 0; n < src_obj->filter_length; n++) {
+			coef = *filter_p++ >> 8;
+			prod0 += (int64_t)(*buffer0_p--) * coef;
+			prod1 += (int64_t)(*buffer1_p--) * coef;
+		}
 
 		/* Shift left after accumulation, because interim
 		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
+		 * << 1; will shift after last addition. Store in
+		 * (de-)interleaved format in the output buffers.
 		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 53, 31));
+		output_buffers[ch][i] = sat_int32(Q_SHIFT(prod0, 53, 31));
+		output_buffers[ch + 1][i] = sat_int32(Q_SHIFT(prod1, 53, 31));
+	}
 
-		/* Store 'prod' in (de-)interleaved format in the output
-		 * buffers
-		 */
-		output_buffers[ch][i] = prod32;
+	/* The last channel if odd count */
+	if (ch < src_obj->num_channels) {
+		prod0 = asrc_fir_mac32(&src_obj->impulse_response[0],
+				       &src_obj->ring_buffers32[ch][pos],
+				       src_obj->filter_length);
+		output_buffers[ch][i] = sat_int32(Q_SHIFT(prod0, 53, 31));
 	}
 }
 
@@ -11,15 +11,29 @@
 
 LOG_MODULE_DECLARE(asrc, CONFIG_SOF_LOG_LEVEL);
 
+/* Add up the lower and upper 32 bit halves of accumulated products with
+ * saturation and shift left with saturation.
+ */
+static inline ae_f32x2 asrc_fir_sum32x2(ae_f32x2 prod)
+{
+	ae_f32x2 swapped = AE_SEL32_LH(prod, prod);
+
+	prod = AE_ADD32S(prod, swapped);
+	return AE_SLAI32S(prod, 1);
+}
+
 void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 		       int index_output_frame)
 {
 	ae_f32x2 prod;
+	ae_f32x2 prod1;
 	ae_f32x2 filter01 = AE_ZERO32(); /* Note: Init is not needed */
 	ae_f32x2 filter23 = AE_ZERO32(); /* Note: Init is not needed */
 	ae_f16x4 buffer0123 = AE_ZERO16(); /* Note: Init is not needed */
+	ae_f16x4 buffer1_0123 = AE_ZERO16(); /* Note: Init is not needed */
 	ae_f32x2 *filter_p;
 	ae_f16x4 *buffer_p;
+	ae_f16x4 *buffer1_p;
 	int n_limit;
 	int ch;
 	int n;
@@ -36,8 +50,43 @@ void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
+	/* Iterate over channel pairs, the four bins of impulse response
+	 * are loaded once for both channels.
+	 */
+	for (ch = 0; ch + 1 < src_obj->num_channels; ch += 2) {
+		filter_p = (ae_f32x2 *)&src_obj->impulse_response[0];
+		buffer_p = (ae_f16x4 *)&src_obj->ring_buffers16[ch]
+			[src_obj->buffer_write_position];
+		buffer1_p = (ae_f16x4 *)&src_obj->ring_buffers16[ch + 1]
+			[src_obj->buffer_write_position];
+
+		ae_valign align_filter = AE_LA64_PP(filter_p);
+		ae_valign align_buffer = AE_LA64_PP(buffer_p);
+		ae_valign align_buffer1 = AE_LA64_PP(buffer1_p);
+
+		prod = AE_ZERO32();
+		prod1 = AE_ZERO32();
+		for (n = 0; n < n_limit; n++) {
+			AE_LA16X4_RIP(buffer0123, align_buffer, buffer_p);
+			AE_LA16X4_RIP(buffer1_0123, align_buffer1, buffer1_p);
+			AE_LA32X2_IP(filter01, align_filter, filter_p);
+			AE_LA32X2_IP(filter23, align_filter, filter_p);
+			AE_MULAFP32X16X2RS_L(prod, filter23, buffer0123);
+			AE_MULAFP32X16X2RS_H(prod, filter01, buffer0123);
+			AE_MULAFP32X16X2RS_L(prod1, filter23, buffer1_0123);
+			AE_MULAFP32X16X2RS_H(prod1, filter01, buffer1_0123);
+		}
+
+		prod = asrc_fir_sum32x2(prod);
+		prod1 = asrc_fir_sum32x2(prod1);
+		AE_S16_0_X(AE_ROUND16X4F32SSYM(prod, prod),
+			   (ae_f16 *)&output_buffers[ch][i], 0);
+		AE_S16_0_X(AE_ROUND16X4F32SSYM(prod1, prod1),
+			   (ae_f16 *)&output_buffers[ch + 1][i], 0);
+	}
+
+	/* The last channel if odd count */
+	for (; ch < src_obj->num_channels; ch++) {
 		/* Pointer to the beginning of the impulse response */
 		filter_p = (ae_f32x2 *)&src_obj->impulse_response[0];
 
@@ -101,10 +150,13 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		       int index_output_frame)
 {
 	ae_f32x2 prod;
+	ae_f32x2 prod1;
 	ae_f32x2 buffer01 = AE_ZERO32(); /* Note: Init is not needed */
+	ae_f32x2 buffer1_01 = AE_ZERO32(); /* Note: Init is not needed */
 	ae_f32x2 filter01 = AE_ZERO32(); /* Note: Init is not needed */
 	ae_f32x2 *filter_p;
 	ae_f32x2 *buffer_p;
+	ae_f32x2 *buffer1_p;
 	int n_limit;
 	int ch;
 	int n;
@@ -121,8 +173,38 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
+	/* Iterate over channel pairs, the two bins of impulse response
+	 * are loaded once for both channels.
+	 */
+	for (ch = 0; ch + 1 < src_obj->num_channels; ch += 2) {
+		filter_p = (ae_f32x2 *)&src_obj->impulse_response[0];
+		buffer_p = (ae_f32x2 *)&src_obj->ring_buffers32[ch]
+			[src_obj->buffer_write_position];
+		buffer1_p = (ae_f32x2 *)&src_obj->ring_buffers32[ch + 1]
+			[src_obj->buffer_write_position];
+
+		ae_valign align_filter = AE_LA64_PP(filter_p);
+		ae_valign align_buffer = AE_LA64_PP(buffer_p);
+		ae_valign align_buffer1 = AE_LA64_PP(buffer1_p);
+
+		prod = AE_ZERO32();
+		prod1 = AE_ZERO32();
+		for (n = 0; n < n_limit; n++) {
+			AE_LA32X2_RIP(buffer01, align_buffer, buffer_p);
+			AE_LA32X2_RIP(buffer1_01, align_buffer1, buffer1_p);
+			AE_LA32X2_IP(filter01, align_filter, filter_p);
+			AE_MULAFP32X2RS(prod, buffer01, filter01);
+			AE_MULAFP32X2RS(prod1, buffer1_01, filter01);
+		}
+
+		prod = asrc_fir_sum32x2(prod);
+		prod1 = asrc_fir_sum32x2(prod1);
+		AE_S32_L_X(prod, (ae_f32 *)&output_buffers[ch][i], 0);
+		AE_S32_L_X(prod1, (ae_f32 *)&output_buffers[ch + 1][i], 0);
+	}
+
+	/* The last channel if odd count */
+	for (; ch < src_obj->num_channels; ch++) {
 		/* Pointer to the beginning of the impulse response */
 		filter_p = (ae_f32x2 *)&src_obj->impulse_response[0];
 
@@ -70,6 +70,16 @@ struct chain_dma_data {
 	struct dma_block_config dma_block_cfg_link;
 
 	struct comp_buffer *dma_buffer;
+
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+	/* watermark driven processing state */
+	uint32_t idle_ticks;		/* ticks to skip before DMA status is polled */
+	uint32_t ticks_since_poll;	/* ticks elapsed since last DMA status poll */
+	uint32_t last_link_pos;		/* link DMA read position at last poll */
+	uint32_t link_rate;		/* link DMA throughput in bytes per tick */
+	uint32_t margin;		/* watermark distance to link xrun in bytes */
+	bool link_pos_valid;
+#endif
 };
 
 static int chain_host_start(struct comp_dev *dev)
@@ -168,6 +178,72 @@ static void handle_xrun(struct chain_dma_data *cd)
 }
 #endif
 
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+static void chain_wm_reset(struct chain_dma_data *cd)
+{
+	const size_t buff_size = audio_stream_get_size(&cd->dma_buffer->stream);
+
+	cd->idle_ticks = 0;
+	cd->ticks_since_poll = 0;
+	cd->link_rate = 0;
+	cd->link_pos_valid = false;
+	cd->margin = buff_size * CONFIG_COMP_CHAIN_DMA_WATERMARK_PCT / 100;
+}
+
+/* Link DMA throughput from read position progress since last poll. The higher of
+ * the smoothed and the current rate is used to not oversleep on rate increase.
+ */
+static void chain_wm_rate_update(struct chain_dma_data *cd, uint32_t link_read_pos)
+{
+	const size_t buff_size = audio_stream_get_size(&cd->dma_buffer->stream);
+	uint32_t ticks = cd->ticks_since_poll + 1;
+	uint32_t rate;
+
+	cd->ticks_since_poll = 0;
+	if (!cd->link_pos_valid) {
+		cd->last_link_pos = link_read_pos;
+		cd->link_pos_valid = true;
+		return;
+	}
+
+	rate = chain_get_transferred_data_size(link_read_pos, cd->last_link_pos,
+					       buff_size) / ticks;
+	cd->last_link_pos = link_read_pos;
+	cd->link_rate = MAX((cd->link_rate * 3 + rate) / 4, rate);
+}
+
+static void chain_wm_xrun(struct chain_dma_data *cd)
+{
+	cd->margin = audio_stream_get_size(&cd->dma_buffer->stream) / 2;
+	cd->idle_ticks = 0;
+}
+
+/**
+ * \brief Sets number of ticks to skip until link DMA level reaches the watermark.
+ * \param[in,out] cd Chain DMA data.
+ * \param[in] observed Distance to link xrun in bytes seen at this poll.
+ * \param[in] distance Bytes left to link xrun once this poll transfers are done.
+ */
+static void chain_wm_schedule(struct chain_dma_data *cd, size_t observed, size_t distance)
+{
+	const size_t max_margin = audio_stream_get_size(&cd->dma_buffer->stream) / 2;
+	const size_t min_margin = 2 * cd->link_rate;
+
+	/* grow watermark fast when the wake up came late, shrink slowly otherwise */
+	if (observed < cd->margin / 2)
+		cd->margin = MIN(cd->margin * 2, max_margin);
+	else
+		cd->margin = MAX(cd->margin - cd->margin / 32, min_margin);
+
+	if (!cd->link_rate || distance <= cd->margin) {
+		cd->idle_ticks = 0;
+		return;
+	}
+
+	cd->idle_ticks = (distance - cd->margin) / cd->link_rate;
+}
+#endif /* CONFIG_COMP_CHAIN_DMA_WATERMARK */
+
 static enum task_state chain_task_run(void *data)
 {
 	size_t link_avail_bytes, link_free_bytes, host_avail_bytes, host_free_bytes;
@@ -177,6 +253,14 @@ static enum task_state chain_task_run(void *data)
 	uint32_t link_type;
 	int ret;
 
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+	if (cd->idle_ticks) {
+		cd->idle_ticks--;
+		cd->ticks_since_poll++;
+		return SOF_TASK_STATE_RESCHEDULE;
+	}
+#endif
+
 	/* Link DMA can return -EPIPE and current status if xrun occurs, then it is not critical
 	 * and flow shall continue. Other error values will be treated as critical.
 	 */
@@ -189,6 +273,9 @@ static enum task_state chain_task_run(void *data)
 			" ret = %u", ret);
 #if CONFIG_XRUN_NOTIFICATIONS_ENABLE
 		handle_xrun(cd);
+#endif
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+		chain_wm_xrun(cd);
 #endif
 		break;
 	default:
@@ -199,6 +286,9 @@ static enum task_state chain_task_run(void *data)
 	link_avail_bytes = stat.pending_length;
 	link_free_bytes = stat.free;
 	link_read_pos = stat.read_position;
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+	chain_wm_rate_update(cd, link_read_pos);
+#endif
 
 	/* Host DMA does not report xruns. All error values will be treated as critical. */
 	ret = dma_get_status(cd->chan_host->dma->z_dev, cd->chan_host->index, &stat);
@@ -232,6 +322,10 @@ static enum task_state chain_task_run(void *data)
 			       "chain_task_run(): dma_reload() link error, ret = %u", ret);
 			return SOF_TASK_STATE_COMPLETED;
 		}
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+		/* link overruns when its free space is used up */
+		chain_wm_schedule(cd, link_free_bytes, link_free_bytes + increment);
+#endif
 	} else {
 		/* PLAYBACK:
 		 * When chained Host Output with Link Output then wait for half buffer full. In this
@@ -254,6 +348,9 @@ static enum task_state chain_task_run(void *data)
 			cd->first_data_received = true;
 
 		} else if (cd->first_data_received) {
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+			size_t link_queued = link_avail_bytes;
+#endif
 			const size_t transferred =
 				chain_get_transferred_data_size(link_read_pos,
 								host_read_pos,
@@ -276,7 +373,14 @@ static enum task_state chain_task_run(void *data)
 					       "link error, ret = %u", ret);
 					return SOF_TASK_STATE_COMPLETED;
 				}
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+				link_queued += half_buff_size;
+#endif
 			}
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+			/* link underruns when its pending data is used up */
+			chain_wm_schedule(cd, link_avail_bytes, link_queued);
+#endif
 		}
 	}
 	return SOF_TASK_STATE_RESCHEDULE;
@@ -328,6 +432,10 @@ static int chain_task_start(struct comp_dev *dev)
 		}
 	}
 
+#if CONFIG_COMP_CHAIN_DMA_WATERMARK
+	chain_wm_reset(cd);
+#endif
+
 	ret = schedule_task_init_ll(&cd->chain_task, SOF_UUID(chain_dma_uuid),
 				    SOF_SCHEDULE_LL_TIMER, SOF_TASK_PRI_HIGH,
 				    chain_task_run, cd, 0, 0);
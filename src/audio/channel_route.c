@@ -0,0 +1,370 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/channel_route.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <rtos/string.h>
+#include <ipc/stream.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Whole frames are copied, the plan routes each channel of the only source
+ * stream to the same sink channel without gain.
+ */
+static void chroute_copy_frames(const struct chroute_plan *plan, void *dst,
+				const void **src, uint32_t frames)
+{
+	size_t bytes = frames * plan->sink_channels *
+		(plan->frame_fmt == SOF_IPC_FRAME_S16_LE ? sizeof(int16_t) : sizeof(int32_t));
+
+	memcpy_s(dst, bytes, src[plan->op[0].tap[0].stream], bytes);
+}
+
+#if CONFIG_FORMAT_S16LE
+static void chroute_copy_s16(const struct chroute_plan *plan, void *dst,
+			     const void **src, uint32_t frames)
+{
+	const struct chroute_op *op;
+	const int16_t *s;
+	int16_t *d;
+	int d_inc = plan->sink_channels;
+	int s_inc;
+	int i, j;
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		d = (int16_t *)dst + op->out_ch;
+		if (!op->num_taps) {
+			for (j = 0; j < frames; j++) {
+				*d = 0;
+				d += d_inc;
+			}
+			continue;
+		}
+
+		s = (const int16_t *)src[op->tap[0].stream] + op->tap[0].in_ch;
+		s_inc = plan->source_channels[op->tap[0].stream];
+		for (j = 0; j < frames; j++) {
+			*d = *s;
+			s += s_inc;
+			d += d_inc;
+		}
+	}
+}
+
+static void chroute_mix_s16(const struct chroute_plan *plan, void *dst,
+			    const void **src, uint32_t frames)
+{
+	const struct chroute_op *op;
+	const struct chroute_tap *tap;
+	const int16_t *s;
+	int16_t *d;
+	int32_t accum;
+	int d_inc = plan->sink_channels;
+	int i, j, k;
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		d = (int16_t *)dst + op->out_ch;
+		for (j = 0; j < frames; j++) {
+			accum = 0;
+			for (k = 0; k < op->num_taps; k++) {
+				tap = &op->tap[k];
+				s = (const int16_t *)src[tap->stream] +
+					j * plan->source_channels[tap->stream] + tap->in_ch;
+				accum += (int32_t)*s * tap->gain;
+			}
+
+			/* shift out 10 LSbits with rounding to get 16-bit result */
+			*d = sat_int16((accum + (1 << (CHROUTE_GAIN_SHIFT - 1))) >>
+				       CHROUTE_GAIN_SHIFT);
+			d += d_inc;
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+static void chroute_copy_s32(const struct chroute_plan *plan, void *dst,
+			     const void **src, uint32_t frames)
+{
+	const struct chroute_op *op;
+	const int32_t *s;
+	int32_t *d;
+	int d_inc = plan->sink_channels;
+	int s_inc;
+	int i, j;
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		d = (int32_t *)dst + op->out_ch;
+		if (!op->num_taps) {
+			for (j = 0; j < frames; j++) {
+				*d = 0;
+				d += d_inc;
+			}
+			continue;
+		}
+
+		s = (const int32_t *)src[op->tap[0].stream] + op->tap[0].in_ch;
+		s_inc = plan->source_channels[op->tap[0].stream];
+		for (j = 0; j < frames; j++) {
+			*d = *s;
+			s += s_inc;
+			d += d_inc;
+		}
+	}
+}
+
+#if CONFIG_FORMAT_S24LE
+static void chroute_mix_s24(const struct chroute_plan *plan, void *dst,
+			    const void **src, uint32_t frames)
+{
+	const struct chroute_op *op;
+	const struct chroute_tap *tap;
+	const int32_t *s;
+	int32_t *d;
+	int64_t accum;
+	int d_inc = plan->sink_channels;
+	int i, j, k;
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		d = (int32_t *)dst + op->out_ch;
+		for (j = 0; j < frames; j++) {
+			accum = 0;
+			for (k = 0; k < op->num_taps; k++) {
+				tap = &op->tap[k];
+				s = (const int32_t *)src[tap->stream] +
+					j * plan->source_channels[tap->stream] + tap->in_ch;
+				accum += (int64_t)*s * tap->gain;
+			}
+
+			/* shift out 10 LSbits with rounding to get 24-bit result */
+			*d = sat_int24((accum + (1 << (CHROUTE_GAIN_SHIFT - 1))) >>
+				       CHROUTE_GAIN_SHIFT);
+			d += d_inc;
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void chroute_mix_s32(const struct chroute_plan *plan, void *dst,
+			    const void **src, uint32_t frames)
+{
+	const struct chroute_op *op;
+	const struct chroute_tap *tap;
+	const int32_t *s;
+	int32_t *d;
+	int64_t accum;
+	int d_inc = plan->sink_channels;
+	int i, j, k;
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		d = (int32_t *)dst + op->out_ch;
+		for (j = 0; j < frames; j++) {
+			accum = 0;
+			for (k = 0; k < op->num_taps; k++) {
+				tap = &op->tap[k];
+				s = (const int32_t *)src[tap->stream] +
+					j * plan->source_channels[tap->stream] + tap->in_ch;
+				accum += (int64_t)*s * tap->gain;
+			}
+
+			/* shift out 10 LSbits with rounding to get 32-bit result */
+			*d = sat_int32((accum + (1 << (CHROUTE_GAIN_SHIFT - 1))) >>
+				       CHROUTE_GAIN_SHIFT);
+			d += d_inc;
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE */
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
+static struct chroute_op *chroute_get_op(struct chroute_plan *plan, int out_ch)
+{
+	struct chroute_op *op;
+	int i;
+
+	for (i = 0; i < plan->num_ops; i++)
+		if (plan->op[i].out_ch == out_ch)
+			return &plan->op[i];
+
+	op = &plan->op[plan->num_ops++];
+	op->out_ch = out_ch;
+	op->num_taps = 0;
+	return op;
+}
+
+/* Frames can be copied as a whole if every sink channel is the same channel of one source */
+static bool chroute_is_identity(const struct chroute_plan *plan)
+{
+	const struct chroute_op *op;
+	int stream;
+	int i;
+
+	if (plan->num_ops != plan->sink_channels || plan->op[0].num_taps != 1)
+		return false;
+
+	stream = plan->op[0].tap[0].stream;
+	if (plan->source_channels[stream] != plan->sink_channels)
+		return false;
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		if (op->num_taps != 1 || op->tap[0].stream != stream ||
+		    op->tap[0].in_ch != op->out_ch)
+			return false;
+	}
+
+	return true;
+}
+
+int chroute_plan_compile(struct chroute_plan *plan, const struct chroute_elem *elems,
+			 int num_elems, enum chroute_mode mode, enum sof_ipc_frame frame_fmt,
+			 uint8_t sink_channels, const uint8_t *source_channels)
+{
+	const struct chroute_elem *elem;
+	struct chroute_op *op;
+	bool copy = true;
+	int i;
+
+	plan->func = NULL;
+	plan->num_ops = 0;
+	plan->frame_fmt = frame_fmt;
+	plan->sink_channels = sink_channels;
+	memcpy_s(plan->source_channels, sizeof(plan->source_channels),
+		 source_channels, sizeof(plan->source_channels));
+
+	for (i = 0; i < num_elems; i++) {
+		elem = &elems[i];
+		if (elem->stream >= CHROUTE_MAX_STREAMS ||
+		    elem->in_ch >= plan->source_channels[elem->stream] ||
+		    elem->out_ch >= plan->sink_channels ||
+		    elem->out_ch >= CHROUTE_MAX_CHANNELS)
+			continue;
+
+		op = chroute_get_op(plan, elem->out_ch);
+		if (mode == CHROUTE_MODE_COPY) {
+			op->tap[0].stream = elem->stream;
+			op->tap[0].in_ch = elem->in_ch;
+			op->tap[0].gain = CHROUTE_UNITY_GAIN;
+			op->num_taps = 1;
+			continue;
+		}
+
+		/* zero gain element only makes sure the sink channel is written */
+		if (!elem->gain)
+			continue;
+
+		if (op->num_taps == CHROUTE_MAX_CHANNELS)
+			return -EINVAL;
+
+		op->tap[op->num_taps].stream = elem->stream;
+		op->tap[op->num_taps].in_ch = elem->in_ch;
+		op->tap[op->num_taps].gain = elem->gain;
+		op->num_taps++;
+	}
+
+	for (i = 0; i < plan->num_ops; i++) {
+		op = &plan->op[i];
+		if (op->num_taps > 1 ||
+		    (op->num_taps && op->tap[0].gain != CHROUTE_UNITY_GAIN))
+			copy = false;
+	}
+
+	if (copy && plan->num_ops && chroute_is_identity(plan)) {
+		plan->func = chroute_copy_frames;
+		return 0;
+	}
+
+	switch (plan->frame_fmt) {
+#if CONFIG_FORMAT_S16LE
+	case SOF_IPC_FRAME_S16_LE:
+		plan->func = copy ? chroute_copy_s16 : chroute_mix_s16;
+		return 0;
+#endif
+#if CONFIG_FORMAT_S24LE
+	case SOF_IPC_FRAME_S24_4LE:
+		plan->func = copy ? chroute_copy_s32 : chroute_mix_s24;
+		return 0;
+#endif
+#if CONFIG_FORMAT_S32LE
+	case SOF_IPC_FRAME_S32_LE:
+		plan->func = copy ? chroute_copy_s32 : chroute_mix_s32;
+		return 0;
+#endif
+	default:
+		return -EINVAL;
+	}
+}
+
+int chroute_plan_update(struct chroute_plan *plan, const struct chroute_elem *elems,
+			int num_elems, enum chroute_mode mode,
+			const struct audio_stream *sink,
+			const struct audio_stream **sources, int num_sources)
+{
+	uint8_t source_channels[CHROUTE_MAX_STREAMS] = { 0 };
+	enum sof_ipc_frame frame_fmt = audio_stream_get_frm_fmt(sink);
+	uint8_t sink_channels = audio_stream_get_channels(sink);
+	int i;
+
+	if (num_sources > CHROUTE_MAX_STREAMS)
+		return -EINVAL;
+
+	for (i = 0; i < num_sources; i++)
+		if (sources[i])
+			source_channels[i] = audio_stream_get_channels(sources[i]);
+
+	/* the plan is reused as long as the stream layout stays the same */
+	if (plan->func && plan->frame_fmt == frame_fmt &&
+	    plan->sink_channels == sink_channels &&
+	    !memcmp(plan->source_channels, source_channels, sizeof(source_channels)))
+		return 0;
+
+	return chroute_plan_compile(plan, elems, num_elems, mode, frame_fmt,
+				    sink_channels, source_channels);
+}
+
+void chroute_process(const struct chroute_plan *plan, struct audio_stream *sink,
+		     const struct audio_stream **sources, uint32_t frames)
+{
+	const void *src[CHROUTE_MAX_STREAMS] = { NULL };
+	void *dst = audio_stream_get_wptr(sink);
+	uint32_t sink_frame_bytes = audio_stream_frame_bytes(sink);
+	uint32_t source_frame_bytes;
+	uint32_t n;
+	int i;
+
+	if (!plan->num_ops)
+		return;
+
+	for (i = 0; i < CHROUTE_MAX_STREAMS; i++)
+		if (plan->source_channels[i])
+			src[i] = audio_stream_get_rptr(sources[i]);
+
+	while (frames) {
+		n = MIN(frames, audio_stream_frames_without_wrap(sink, dst));
+		for (i = 0; i < CHROUTE_MAX_STREAMS; i++)
+			if (src[i])
+				n = MIN(n, audio_stream_frames_without_wrap(sources[i], src[i]));
+
+		plan->func(plan, dst, src, n);
+
+		dst = audio_stream_wrap(sink, (uint8_t *)dst + n * sink_frame_bytes);
+		for (i = 0; i < CHROUTE_MAX_STREAMS; i++)
+			if (src[i]) {
+				source_frame_bytes = audio_stream_frame_bytes(sources[i]);
+				src[i] = audio_stream_wrap(sources[i], (uint8_t *)src[i] +
+							   n * source_frame_bytes);
+			}
+
+		frames -= n;
+	}
+}
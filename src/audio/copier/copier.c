@@ -538,15 +538,75 @@ static int copier_module_copy(struct processing_module *mod,
 	return 0;
 }
 
+/* Endpoints can be gathered into or scattered from the pipeline buffer directly
+ * when the aggregated stream is the only stream produced or consumed by the copier
+ * and the conversion to or from the pipeline buffer would be a plain copy.
+ */
+static struct comp_buffer *copier_multi_endpoint_direct_buffer(struct copier_data *cd,
+							       struct comp_dev *dev)
+{
+	struct audio_stream *multi = &cd->multi_endpoint_buffer->stream;
+	struct comp_buffer *buffer;
+	int pin = IPC4_COPIER_GATEWAY_PIN;
+
+	/* data left in the aggregated stream must be passed on first */
+	if (audio_stream_get_avail_bytes(multi))
+		return NULL;
+
+	if (!cd->bsource_buffer) {
+		/* only one sink */
+		if (list_is_empty(&dev->bsink_list) ||
+		    dev->bsink_list.next->next != &dev->bsink_list)
+			return NULL;
+
+		buffer = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+		if (buffer->sink->state != COMP_STATE_ACTIVE)
+			return NULL;
+
+		/* converted by the converter of the sink queue being written */
+		pin = IPC4_SINK_QUEUE_ID(buf_get_id(buffer));
+		if (pin >= IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT)
+			return NULL;
+	} else {
+		buffer = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+	}
+
+	/* sample layout differs between the gateway and the pipeline, e.g. MSB
+	 * aligned 24-bit samples on ALH, the converter must run
+	 */
+	if (cd->converter[pin] != audio_stream_copy)
+		return NULL;
+
+	if (!buffer->hw_params_configured ||
+	    audio_stream_get_frm_fmt(&buffer->stream) != audio_stream_get_frm_fmt(multi) ||
+	    audio_stream_get_valid_fmt(&buffer->stream) != audio_stream_get_valid_fmt(multi) ||
+	    audio_stream_get_channels(&buffer->stream) != audio_stream_get_channels(multi))
+		return NULL;
+
+	return buffer;
+}
+
 static int copier_multi_endpoint_dai_copy(struct copier_data *cd, struct comp_dev *dev)
 {
 	struct comp_copy_limits processed_data;
+	struct comp_buffer *direct;
 	struct comp_buffer *src;
 	int ret;
 
 	processed_data.source_bytes = 0;
 
 	if (!cd->bsource_buffer) {
+		direct = copier_multi_endpoint_direct_buffer(cd, dev);
+		if (direct) {
+			/* gateway(s) gathered into the sink in a single pass */
+			ret = dai_zephyr_multi_endpoint_copy(cd->dd, dev, direct,
+							     cd->endpoint_num);
+			if (ret > 0)
+				cd->output_total_data_processed += ret;
+
+			return ret < 0 ? ret : 0;
+		}
+
 		/* gateway(s) as input */
 		ret = dai_zephyr_multi_endpoint_copy(cd->dd, dev, cd->multi_endpoint_buffer,
 						     cd->endpoint_num);
@@ -564,6 +624,16 @@ static int copier_multi_endpoint_dai_copy(struct copier_data *cd, struct comp_de
 		return -EINVAL;
 	}
 
+	direct = copier_multi_endpoint_direct_buffer(cd, dev);
+	if (direct) {
+		/* gateway(s) scattered from the source in a single pass */
+		ret = dai_zephyr_multi_endpoint_copy(cd->dd, dev, direct, cd->endpoint_num);
+		if (ret > 0)
+			cd->input_total_data_processed += ret;
+
+		return ret < 0 ? ret : 0;
+	}
+
 	src = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
 
 	/* gateway(s) on output */
@@ -573,12 +643,12 @@ static int copier_multi_endpoint_dai_copy(struct copier_data *cd, struct comp_de
 
 	ret = dai_zephyr_multi_endpoint_copy(cd->dd, dev, cd->multi_endpoint_buffer,
 					     cd->endpoint_num);
-	if (!ret) {
+	if (ret >= 0) {
 		comp_update_buffer_consume(src, processed_data.source_bytes);
 		cd->input_total_data_processed += processed_data.source_bytes;
 	}
 
-	return ret;
+	return ret < 0 ? ret : 0;
 }
 
 /* Copier has one input and one or more outputs. Maximum of one gateway can be connected
@@ -368,88 +368,6 @@ int copier_dai_prepare(struct comp_dev *dev, struct copier_data *cd)
 	return 0;
 }
 
-static int copy_single_channel_c16(const struct audio_stream *src,
-				   unsigned int src_channel,
-				   struct audio_stream *dst,
-				   unsigned int dst_channel, unsigned int frame_count)
-{
-	int16_t *r_ptr = (int16_t *)audio_stream_get_rptr(src) + src_channel;
-	int16_t *w_ptr = (int16_t *)audio_stream_get_wptr(dst) + dst_channel;
-
-	/* We have to iterate over frames here. However, tracking frames requires using
-	 * of expensive division operations (e.g., inside audio_stream_frames_without_wrap()).
-	 * So let's track samples instead. Since we only copy one channel, src_stream_sample_count
-	 * is NOT number of samples we need to copy but total samples for all channels. We just
-	 * track them to know when to stop.
-	 */
-	int src_stream_sample_count = frame_count * audio_stream_get_channels(src);
-
-	while (src_stream_sample_count) {
-		int src_samples_without_wrap;
-		int16_t *r_end_ptr, *r_ptr_before_loop;
-
-		r_ptr = audio_stream_wrap(src, r_ptr);
-		w_ptr = audio_stream_wrap(dst, w_ptr);
-
-		src_samples_without_wrap = audio_stream_samples_without_wrap_s16(src, r_ptr);
-		r_end_ptr = src_stream_sample_count < src_samples_without_wrap ?
-			r_ptr + src_stream_sample_count : (int16_t *)audio_stream_get_end_addr(src);
-
-		r_ptr_before_loop = r_ptr;
-
-		do {
-			*w_ptr = *r_ptr;
-			r_ptr += audio_stream_get_channels(src);
-			w_ptr += audio_stream_get_channels(dst);
-		} while (r_ptr < r_end_ptr && w_ptr < (int16_t *)audio_stream_get_end_addr(dst));
-
-		src_stream_sample_count -= r_ptr - r_ptr_before_loop;
-	}
-
-	return 0;
-}
-
-static int copy_single_channel_c32(const struct audio_stream *src,
-				   unsigned int src_channel,
-				   struct audio_stream *dst,
-				   unsigned int dst_channel, unsigned int frame_count)
-{
-	int32_t *r_ptr = (int32_t *)audio_stream_get_rptr(src) + src_channel;
-	int32_t *w_ptr = (int32_t *)audio_stream_get_wptr(dst) + dst_channel;
-
-	/* We have to iterate over frames here. However, tracking frames requires using
-	 * of expensive division operations (e.g., inside audio_stream_frames_without_wrap()).
-	 * So let's track samples instead. Since we only copy one channel, src_stream_sample_count
-	 * is NOT number of samples we need to copy but total samples for all channels. We just
-	 * track them to know when to stop.
-	 */
-	int src_stream_sample_count = frame_count * audio_stream_get_channels(src);
-
-	while (src_stream_sample_count) {
-		int src_samples_without_wrap;
-		int32_t *r_end_ptr, *r_ptr_before_loop;
-
-		r_ptr = audio_stream_wrap(src, r_ptr);
-		w_ptr = audio_stream_wrap(dst, w_ptr);
-
-		src_samples_without_wrap = audio_stream_samples_without_wrap_s32(src, r_ptr);
-		r_end_ptr = src_stream_sample_count < src_samples_without_wrap ?
-			r_ptr + src_stream_sample_count : (int32_t *)audio_stream_get_end_addr(src);
-
-		r_ptr_before_loop = r_ptr;
-
-		do {
-			*w_ptr = *r_ptr;
-			r_ptr += audio_stream_get_channels(src);
-			w_ptr += audio_stream_get_channels(dst);
-		} while (r_ptr < r_end_ptr && w_ptr < (int32_t *)audio_stream_get_end_addr(dst));
-
-		src_stream_sample_count -= r_ptr - r_ptr_before_loop;
-	}
-
-	return 0;
-}
-
 int copier_dai_params(struct copier_data *cd, struct comp_dev *dev,
 		      struct sof_ipc_stream_params *params, int dai_index)
 {
@@ -497,17 +415,9 @@ int copier_dai_params(struct copier_data *cd, struct comp_dev *dev,
 	for (j = 0; j < SOF_IPC_MAX_CHANNELS; j++)
 		cd->dd[dai_index]->dma_buffer->chmap[j] = (cd->chan_map[dai_index] >> j * 4) & 0xf;
 
-	/* set channel copy func */
+	/* endpoint channels are moved to or from the aggregated stream as they are */
 	container_size = audio_stream_sample_bytes(&cd->multi_endpoint_buffer->stream);
-
-	switch (container_size) {
-	case 2:
-		cd->dd[dai_index]->process = copy_single_channel_c16;
-		break;
-	case 4:
-		cd->dd[dai_index]->process = copy_single_channel_c32;
-		break;
-	default:
+	if (container_size != sizeof(int16_t) && container_size != sizeof(int32_t)) {
 		comp_err(dev, "Unexpected container size: %d", container_size);
 		return -EINVAL;
 	}
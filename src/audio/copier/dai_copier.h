@@ -53,6 +53,11 @@ int dai_common_ts_get(struct dai_data *dd, struct comp_dev *dev, struct timestam
 int dai_common_get_hw_params(struct dai_data *dd, struct comp_dev *dev,
 			     struct sof_ipc_stream_params *params, int dir);
 
+/*
+ * Moves data between DMA buffers of all endpoints and the aggregated stream in
+ * multi_endpoint_buffer. Returns number of bytes consumed from or produced to
+ * multi_endpoint_buffer, or error code.
+ */
 #if CONFIG_LIBRARY
 static inline int dai_zephyr_multi_endpoint_copy(struct dai_data **dd, struct comp_dev *dev,
 						 struct comp_buffer *multi_endpoint_buffer,
@@ -348,13 +348,91 @@ dai_dma_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t bytes,
 	return dma_status;
 }
 
+static void dai_route_c16(const void *src, void *dst, const uint8_t *src_idx,
+			  const uint8_t *dst_idx, int channels, int src_channels,
+			  int dst_channels, uint32_t frames)
+{
+	const int16_t *s = src;
+	int16_t *d = dst;
+	int i;
+
+	while (frames--) {
+		for (i = 0; i < channels; i++)
+			d[dst_idx[i]] = s[src_idx[i]];
+		s += src_channels;
+		d += dst_channels;
+	}
+}
+
+static void dai_route_c32(const void *src, void *dst, const uint8_t *src_idx,
+			  const uint8_t *dst_idx, int channels, int src_channels,
+			  int dst_channels, uint32_t frames)
+{
+	const int32_t *s = src;
+	int32_t *d = dst;
+	int i;
+
+	while (frames--) {
+		for (i = 0; i < channels; i++)
+			d[dst_idx[i]] = s[src_idx[i]];
+		s += src_channels;
+		d += dst_channels;
+	}
+}
+
+/* Scatter frames of the aggregated stream to the endpoint DMA buffer on playback
+ * or gather them from it on capture. All endpoint channels are moved in a single
+ * pass over the frames, the DMA buffer channel map gives the position of each
+ * endpoint channel in the aggregated frame.
+ */
+static void dai_multi_endpoint_route(struct dai_data *dd, struct audio_stream *stream,
+				     uint32_t frames, bool playback)
+{
+	struct audio_stream *dma = &dd->dma_buffer->stream;
+	struct audio_stream *src = playback ? stream : dma;
+	struct audio_stream *dst = playback ? dma : stream;
+	uint32_t src_frame_bytes = audio_stream_frame_bytes(src);
+	uint32_t dst_frame_bytes = audio_stream_frame_bytes(dst);
+	int channels = MIN(audio_stream_get_channels(dma), SOF_IPC_MAX_CHANNELS);
+	uint8_t src_idx[SOF_IPC_MAX_CHANNELS];
+	uint8_t dst_idx[SOF_IPC_MAX_CHANNELS];
+	uint8_t *r = audio_stream_get_rptr(src);
+	uint8_t *w = audio_stream_get_wptr(dst);
+	uint32_t n;
+	int i;
+
+	/* interleaving descriptor, sample index in source and destination frame */
+	for (i = 0; i < channels; i++) {
+		src_idx[i] = playback ? dd->dma_buffer->chmap[i] : i;
+		dst_idx[i] = playback ? i : dd->dma_buffer->chmap[i];
+	}
+
+	while (frames) {
+		n = MIN(frames, audio_stream_frames_without_wrap(src, r));
+		n = MIN(n, audio_stream_frames_without_wrap(dst, w));
+
+		if (audio_stream_sample_bytes(dma) == sizeof(int16_t))
+			dai_route_c16(r, w, src_idx, dst_idx, channels,
+				      audio_stream_get_channels(src),
+				      audio_stream_get_channels(dst), n);
+		else
+			dai_route_c32(r, w, src_idx, dst_idx, channels,
+				      audio_stream_get_channels(src),
+				      audio_stream_get_channels(dst), n);
+
+		r = audio_stream_wrap(src, r + n * src_frame_bytes);
+		w = audio_stream_wrap(dst, w + n * dst_frame_bytes);
+		frames -= n;
+	}
+}
+
 /* this is called by DMA driver every time descriptor has completed */
 static enum dma_cb_status
 dai_dma_multi_endpoint_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t frames,
 			  struct comp_buffer *multi_endpoint_buffer)
 {
 	enum dma_cb_status dma_status = DMA_CB_STATUS_RELOAD;
-	uint32_t i, bytes;
+	uint32_t bytes;
 
 	comp_dbg(dev, "dai_dma_multi_endpoint_cb()");
 
@@ -381,17 +459,8 @@ dai_dma_multi_endpoint_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t fr
 	if (dev->direction == SOF_IPC_STREAM_CAPTURE)
 		audio_stream_invalidate(&dd->dma_buffer->stream, bytes);
 
-	/* copy all channels one by one */
-	for (i = 0; i < audio_stream_get_channels(&dd->dma_buffer->stream); i++) {
-		uint32_t multi_buf_channel = dd->dma_buffer->chmap[i];
-
-		if (dev->direction == SOF_IPC_STREAM_PLAYBACK)
-			dd->process(&multi_endpoint_buffer->stream, multi_buf_channel,
-				    &dd->dma_buffer->stream, i, frames);
-		else
-			dd->process(&dd->dma_buffer->stream, i, &multi_endpoint_buffer->stream,
-				    multi_buf_channel, frames);
-	}
+	dai_multi_endpoint_route(dd, &multi_endpoint_buffer->stream, frames,
+				 dev->direction == SOF_IPC_STREAM_PLAYBACK);
 
 	if (dev->direction == SOF_IPC_STREAM_PLAYBACK) {
 		audio_stream_writeback(&dd->dma_buffer->stream, bytes);
@@ -1329,7 +1398,9 @@ static void dai_report_xrun(struct dai_data *dd, struct comp_dev *dev, uint32_t
 	}
 }
 
-/* process and copy stream data from multiple DMA source buffers to sink buffer */
+/* process and copy stream data from multiple DMA source buffers to sink buffer,
+ * returns number of bytes consumed from or produced to multi_endpoint_buffer
+ */
 int dai_zephyr_multi_endpoint_copy(struct dai_data **dd, struct comp_dev *dev,
 				   struct comp_buffer *multi_endpoint_buffer,
 				   int num_endpoints)
@@ -1448,7 +1519,7 @@ int dai_zephyr_multi_endpoint_copy(struct dai_data **dd, struct comp_dev *dev,
 		comp_update_buffer_produce(multi_endpoint_buffer, frames * frame_bytes);
 	}
 
-	return 0;
+	return frames * frame_bytes;
 }
 
 static void set_new_local_buffer(struct dai_data *dd, struct comp_dev *dev)
@@ -1585,6 +1656,13 @@ int dai_common_copy(struct dai_data *dd, struct comp_dev *dev, pcm_converter_fun
 			  copy_bytes, free_bytes, dd->period_bytes);
 #endif
 
+	/* margin left in the DMA buffer once this copy is done */
+	if (dev->state == COMP_STATE_ACTIVE)
+		pipeline_xrun_predict(dev->pipeline, dev,
+				      copy_bytes + (dev->direction == SOF_IPC_STREAM_PLAYBACK ?
+						    avail_bytes : free_bytes),
+				      avail_bytes + free_bytes);
+
 	/* return if nothing to copy */
 	if (!copy_bytes) {
 #if CONFIG_DAI_VERBOSE_GLITCH_WARNINGS
@@ -36,39 +36,133 @@ LOG_MODULE_REGISTER(mfcc_common, CONFIG_SOF_LOG_LEVEL);
  * The main processing function for MFCC
  */
 
-static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *state)
+/* Convert a FFT spectrum to Mel band log energies and, unless Mel output is
+ * requested, to cepstral coefficients. The result is stored to out and the
+ * pointer to next output vector is returned.
+ */
+#if MFCC_FFT_BITS == 16
+static int16_t *mfcc_spectrum_to_output(struct mfcc_state *state, struct icomplex16 *spectrum,
+					int mel_scale_shift, int16_t *out)
+#else
+static int16_t *mfcc_spectrum_to_output(struct mfcc_state *state, struct icomplex32 *spectrum,
+					int mel_scale_shift, int16_t *out)
+#endif
+{
+	/* Convert powerspectrum to Mel band logarithmic spectrum */
+	mat_init_16b(state->mel_spectra, 1, state->dct.num_in, 7); /* Q8.7 */
+#if MFCC_FFT_BITS == 16
+	psy_apply_mel_filterbank_16(&state->melfb, spectrum, state->power_spectra,
+				    state->mel_spectra->data, mel_scale_shift);
+#else
+	psy_apply_mel_filterbank_32(&state->melfb, spectrum, state->power_spectra,
+				    state->mel_spectra->data, mel_scale_shift);
+#endif
+
+	if (state->mel_output) {
+		memcpy_s(out, state->out_size * sizeof(int16_t), state->mel_spectra->data,
+			 state->dct.num_in * sizeof(int16_t));
+		return out + state->out_size;
+	}
+
+	/* Multiply Mel spectra with DCT matrix to get cepstral coefficients */
+	mat_init_16b(state->cepstral_coef, 1, state->dct.num_out, 7); /* Q8.7 */
+	mat_multiply(state->mel_spectra, state->dct.matrix, state->cepstral_coef);
+
+	/* Apply cepstral lifter */
+	if (state->lifter.cepstral_lifter != 0)
+		mat_multiply_elementwise(state->cepstral_coef, state->lifter.matrix,
+					 state->cepstral_coef);
+
+	memcpy_s(out, state->out_size * sizeof(int16_t), state->cepstral_coef->data,
+		 state->dct.num_out * sizeof(int16_t));
+	return out + state->out_size;
+}
+
+#if CONFIG_COMP_MFCC_STREAMING
+/* Move the windowed first hop of a pair to imaginary part of FFT input, the
+ * second hop is then filled to real part.
+ */
+static void mfcc_move_fft_buffer_to_imag(struct mfcc_fft *fft)
+{
+	struct icomplex32 *x = &fft->fft_buf[fft->fft_fill_start_idx];
+	int j;
+
+	for (j = 0; j < fft->fft_size; j++) {
+		x[j].imag = x[j].real;
+		x[j].real = 0;
+	}
+}
+
+/* Separate the spectra of two real signals from FFT of z = x2 + j * x1:
+ * X2(k) = (Z(k) + conj(Z(N - k))) / 2, X1(k) = (Z(k) - conj(Z(N - k))) / 2j.
+ * The spectrum of first hop is placed to start of fft_spectra and the spectrum
+ * of the second hop after it.
+ */
+static void mfcc_separate_spectra(struct mfcc_fft *fft)
+{
+	struct icomplex32 *z = fft->fft_out;
+	struct icomplex32 *x1 = fft->fft_spectra;
+	struct icomplex32 *x2 = fft->fft_spectra + fft->half_fft_size;
+	int mask = fft->fft_padded_size - 1;
+	int k;
+	int n;
+
+	for (k = 0; k < fft->half_fft_size; k++) {
+		n = (fft->fft_padded_size - k) & mask;
+		x1[k].real = ((int64_t)z[k].imag + z[n].imag) >> 1;
+		x1[k].imag = ((int64_t)z[n].real - z[k].real) >> 1;
+		x2[k].real = ((int64_t)z[k].real + z[n].real) >> 1;
+		x2[k].imag = ((int64_t)z[k].imag - z[n].imag) >> 1;
+	}
+}
+
+static int mfcc_stft_hops(struct mfcc_state *state, int hops)
 {
-	struct mfcc_buffer *buf = &state->buf;
 	struct mfcc_fft *fft = &state->fft;
-	int mel_scale_shift;
-	int input_shift;
+	int16_t *out = state->out_data + state->out_pending * state->out_size;
+	int mel_scale_shift = -fft->fft_plan->len;
+	bool pair;
 	int i;
-	int m;
-	int cc_count = 0;
 
-	/* Phase 1, wait until whole fft_size is filled with valid data. This way
-	 * first output cepstral coefficients originate from streamed data and not
-	 * from buffers with zero data.
-	 */
-	comp_dbg(dev, "mfcc_stft_process(), avail = %d", buf->s_avail);
-	if (state->waiting_fill) {
-		if (buf->s_avail < fft->fft_size)
-			return 0;
+	for (i = 0; i < hops; i += 2) {
+		/* Clear FFT input buffer because it has been used as scratch */
+		bzero(fft->fft_buf, fft->fft_buffer_size);
+		mfcc_fill_fft_buffer(state);
+		mfcc_apply_window(state, 0);
 
-		state->waiting_fill = false;
-	}
+		/* The second hop of pair, if available, goes to real part */
+		pair = i + 1 < hops;
+		if (pair) {
+			mfcc_move_fft_buffer_to_imag(fft);
+			mfcc_fill_fft_buffer(state);
+			mfcc_apply_window(state, 0);
+		}
 
-	/* Phase 2, move first prev_size data to previous data buffer, remove
-	 * samples from input buffer.
-	 */
-	if (!state->prev_samples_valid) {
-		mfcc_fill_prev_samples(buf, state->prev_data, state->prev_data_size);
-		state->prev_samples_valid = true;
+		bzero(fft->fft_out, fft->fft_buffer_size);
+		fft_execute_32(fft->fft_plan, false);
+		mfcc_separate_spectra(fft);
+
+		/* A single hop is in real part, its spectrum is the second one */
+		if (pair)
+			out = mfcc_spectrum_to_output(state, fft->fft_spectra, mel_scale_shift,
+						      out);
+
+		out = mfcc_spectrum_to_output(state, fft->fft_spectra + fft->half_fft_size,
+					      mel_scale_shift, out);
 	}
 
-	/* Check if enough samples in buffer for FFT hop */
-	m = buf->s_avail / fft->fft_hop_size;
-	for (i = 0; i < m; i++) {
+	return hops;
+}
+#else
+static int mfcc_stft_hops(struct mfcc_state *state, int hops)
+{
+	struct mfcc_fft *fft = &state->fft;
+	int16_t *out = state->out_data + state->out_pending * state->out_size;
+	int mel_scale_shift;
+	int input_shift;
+	int i;
+
+	for (i = 0; i < hops; i++) {
 		/* Clear FFT input buffer because it has been used as scratch */
 		bzero(fft->fft_buf, fft->fft_buffer_size);
 
@@ -103,40 +197,76 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 		fft_execute_32(fft->fft_plan, false);
 #endif
 
-		/* Convert powerspectrum to Mel band logarithmic spectrum */
-		mat_init_16b(state->mel_spectra, 1, state->dct.num_in, 7); /* Q8.7 */
-
 		/* Compensate FFT lib scaling to Mel log values, e.g. for 512 long FFT
 		 * the fft_plan->len is 9. The scaling is 1/512. Subtract from input_shift it
 		 * to add the missing "gain".
 		 */
 		mel_scale_shift = input_shift - fft->fft_plan->len;
-#if MFCC_FFT_BITS == 16
-		psy_apply_mel_filterbank_16(&state->melfb, fft->fft_out, state->power_spectra,
-					    state->mel_spectra->data, mel_scale_shift);
-#else
-		psy_apply_mel_filterbank_32(&state->melfb, fft->fft_out, state->power_spectra,
-					    state->mel_spectra->data, mel_scale_shift);
+		out = mfcc_spectrum_to_output(state, fft->fft_out, mel_scale_shift, out);
+	}
+
+	return hops;
+}
 #endif
 
-		/* Multiply Mel spectra with DCT matrix to get cepstral coefficients */
-		mat_init_16b(state->cepstral_coef, 1, state->dct.num_out, 7); /* Q8.7 */
-		mat_multiply(state->mel_spectra, state->dct.matrix, state->cepstral_coef);
+/* Returns the number of hops that were processed, the output vectors for
+ * them are in state->out_data after the vectors carried over from previous
+ * period.
+ */
+static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *state)
+{
+	struct mfcc_buffer *buf = &state->buf;
+	struct mfcc_fft *fft = &state->fft;
+	int room;
+	int m;
+	int i;
 
-		/* Apply cepstral lifter */
-		if (state->lifter.cepstral_lifter != 0)
-			mat_multiply_elementwise(state->cepstral_coef, state->lifter.matrix,
-						 state->cepstral_coef);
+	/* Phase 1, wait until whole fft_size is filled with valid data. This way
+	 * first output cepstral coefficients originate from streamed data and not
+	 * from buffers with zero data.
+	 */
+	comp_dbg(dev, "mfcc_stft_process(), avail = %d", buf->s_avail);
+	if (state->waiting_fill) {
+		if (buf->s_avail < fft->fft_size)
+			return 0;
 
-		cc_count += state->dct.num_out;
+		state->waiting_fill = false;
+	}
 
-		/* Output to sink buffer */
+	/* Phase 2, move first prev_size data to previous data buffer, remove
+	 * samples from input buffer.
+	 */
+	if (!state->prev_samples_valid) {
+		mfcc_fill_prev_samples(buf, state->prev_data, state->prev_data_size);
+		state->prev_samples_valid = true;
 	}
 
-	/* TODO: This version handles only one FFT run per copy(). How to pass multiple
-	 * cepstral coefficients sets return is an open.
+	/* Check how many FFT hops there are samples for in buffer */
+	m = buf->s_avail / fft->fft_hop_size;
+
+	/* If the sink has not kept up with the carried over output vectors,
+	 * skip the oldest hops. Their samples are consumed to keep the input
+	 * buffer from overflowing.
 	 */
-	return cc_count;
+	room = state->max_out_hops - state->out_pending;
+	if (m > room) {
+		for (i = 0; i < m - room; i++)
+			mfcc_fill_fft_buffer(state);
+
+		/* warn once per overload, the count is reported when it ends */
+		if (!state->dropping)
+			comp_warn(dev, "mfcc_stft_process(), output overload, dropping hops");
+
+		state->dropping = true;
+		state->dropped_hops += m - room;
+		m = room;
+	} else if (state->dropping) {
+		state->dropping = false;
+		comp_warn(dev, "mfcc_stft_process(), overload ended, dropped %u hops in total",
+			  state->dropped_hops);
+	}
+
+	return mfcc_stft_hops(state, m);
 }
 
 #if CONFIG_FORMAT_S16LE
@@ -149,29 +279,42 @@ void mfcc_s16_default(struct processing_module *mod, struct input_stream_buffer
 	struct mfcc_buffer *buf = &cd->state.buf;
 	uint32_t magic = MFCC_MAGIC;
 	int16_t *w_ptr = audio_stream_get_wptr(sink);
+	int16_t *r_ptr = state->out_data;
 	// int num_magic = sizeof(magic) / sizeof(int16_t);
 	const int num_magic = 2;
-	int num_ceps;
+	int num_hops;
 	int zero_samples;
+	int i;
 
 	/* Get samples from source buffer */
 	mfcc_source_copy_s16(bsource, buf, &state->emph, frames, state->source_channel);
 
-	/* Run STFT and processing after FFT: Mel auditory filter and DCT. The sink
-	 * buffer is updated during STDF processing.
+	/* Run STFT and processing after FFT: Mel auditory filter and DCT. The output
+	 * vectors of all processed hops are stored to state->out_data.
 	 */
-	num_ceps = mfcc_stft_process(mod->dev, state);
+	num_hops = mfcc_stft_process(mod->dev, state);
 
-	/* Done, copy data to sink. This works only if the period has room for magic (2)
-	 * plus num_ceps int16_t samples. TODO: split ceps over multiple periods.
+	/* Done, copy data to sink, each hop with magic (2) plus out_size int16_t
+	 * samples. The hops those don't fit into period are carried over to
+	 * next period.
 	 */
+	num_hops += state->out_pending;
 	zero_samples = frames * audio_stream_get_channels(sink);
-	if (num_ceps > 0) {
-		zero_samples -= num_ceps + num_magic;
+	for (i = 0; i < num_hops; i++) {
+		if (zero_samples < num_magic + state->out_size)
+			break;
+
+		zero_samples -= num_magic + state->out_size;
 		w_ptr = mfcc_sink_copy_data_s16(sink, w_ptr, num_magic, (int16_t *)&magic);
-		w_ptr = mfcc_sink_copy_data_s16(sink, w_ptr, num_ceps, state->cepstral_coef->data);
+		w_ptr = mfcc_sink_copy_data_s16(sink, w_ptr, state->out_size, r_ptr);
+		r_ptr += state->out_size;
 	}
 
+	state->out_pending = num_hops - i;
+	if (state->out_pending)
+		memmove(state->out_data, r_ptr,
+			state->out_pending * state->out_size * sizeof(int16_t));
+
 	w_ptr = mfcc_sink_copy_zero_s16(sink, w_ptr, zero_samples);
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -163,10 +163,14 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	/* Calculated parameters */
 	state->prev_data_size = fft->fft_size - fft->fft_hop_size;
 	state->buffer_size = fft->fft_size + max_frames;
+	state->mel_output = config->mel_output;
+	state->out_size = config->mel_output ? config->num_mel_bins : config->num_ceps;
+	state->max_out_hops = max_frames / fft->fft_hop_size + 1;
 
-	/* Allocate buffer input samples and overlap buffer */
+	/* Allocate buffer input samples, overlap buffer, window, and output data */
 	state->sample_buffers_size = sizeof(int16_t) *
-		(state->buffer_size + state->prev_data_size + fft->fft_size);
+		(state->buffer_size + state->prev_data_size + fft->fft_size +
+		 state->max_out_hops * state->out_size);
 
 	comp_info(dev, "mfcc_setup(), buffer_size = %d, prev_size = %d",
 		  state->buffer_size, state->prev_data_size);
@@ -182,6 +186,7 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	mfcc_init_buffer(&state->buf, state->buffers, state->buffer_size);
 	state->prev_data = state->buffers + state->buffer_size;
 	state->window = state->prev_data + state->prev_data_size;
+	state->out_data = state->window + fft->fft_size;
 
 	/* Allocate buffers for FFT input and output data */
 #if MFCC_FFT_BITS == 16
@@ -203,6 +208,16 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 		goto free_fft_buf;
 	}
 
+#if CONFIG_COMP_MFCC_STREAMING
+	fft->fft_spectra = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				   2 * fft->half_fft_size * sizeof(struct icomplex32));
+	if (!fft->fft_spectra) {
+		comp_err(dev, "mfcc_setup(): Failed FFT spectra allocate");
+		ret = -ENOMEM;
+		goto free_fft_out;
+	}
+#endif
+
 	fft->fft_fill_start_idx = 0; /* From config pad_type */
 
 	/* Setup FFT */
@@ -294,6 +309,9 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	/* Set initial state for STFT */
 	state->waiting_fill = true;
 	state->prev_samples_valid = false;
+	state->out_pending = 0;
+	state->dropped_hops = 0;
+	state->dropping = false;
 
 	comp_dbg(dev, "mfcc_setup(), done");
 	return 0;
@@ -305,6 +323,9 @@ free_melfb_data:
 	rfree(fb->data);
 
 free_fft_out:
+#if CONFIG_COMP_MFCC_STREAMING
+	rfree(fft->fft_spectra);
+#endif
 	rfree(fft->fft_out);
 
 free_fft_buf:
@@ -322,6 +343,9 @@ void mfcc_free_buffers(struct mfcc_comp_data *cd)
 	fft_plan_free(cd->state.fft.fft_plan);
 	rfree(cd->state.fft.fft_buf);
 	rfree(cd->state.fft.fft_out);
+#if CONFIG_COMP_MFCC_STREAMING
+	rfree(cd->state.fft.fft_spectra);
+#endif
 	rfree(cd->state.buffers);
 	rfree(cd->state.melfb.data);
 	rfree(cd->state.dct.matrix);
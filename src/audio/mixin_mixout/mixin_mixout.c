@@ -14,6 +14,7 @@
 #include <sof/ipc/msg.h>
 #include <rtos/alloc.h>
 #include <rtos/init.h>
+#include <rtos/interrupt.h>
 #include <sof/lib/memory.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
@@ -62,21 +63,24 @@ DECLARE_TR_CTX(mixout_tr, SOF_UUID(mixout_uuid), LOG_LEVEL_INFO);
  *
  * Such implementation has less buffer reads/writes than simple implementation
  * using intermediate buffer between mixin and mixout.
+ *
+ * With CONFIG_MIXIN_MIXOUT_FUSED_MIX a mixin that has a single mixout does
+ * nothing in mixin_process() if the mixout has a fused function for its format.
+ * Instead mixout_process() pulls the data of all such mixins and accumulates
+ * them in one pass with a single saturation. A mixin connected to several
+ * mixouts still mixes on its own as described above, and its data in mixout
+ * sink is then just one more input of the fused sum.
  */
 
-struct mixin_sink_config {
-	enum ipc4_mixer_mode mixer_mode;
-	uint32_t output_channel_count;
-	uint32_t output_channel_map;
-	/* Gain as described in struct ipc4_mixer_mode_sink_config */
-	uint16_t gain;
-};
-
 /* mixin component private data */
 struct mixin_data {
 	mix_func mix;
 	mix_func gain_mix;
 	struct mixin_sink_config sink_config[MIXIN_MAX_SINKS];
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	/* source of the mixin, mixed by mixout_process() when the mixin is pulled */
+	struct sof_source *source;
+#endif
 };
 
 /*
@@ -112,6 +116,10 @@ struct mixout_data {
 	 */
 	struct cir_buf_ptr acquired_buf;
 	uint32_t acquired_buf_free_frames;
+
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	mix_n_func mix_n;
+#endif
 };
 
 /* NULL is also a valid mixin argument: in such case the function returns first unused entry */
@@ -127,6 +135,62 @@ static struct pending_frames *get_mixin_pending_frames(struct mixout_data *mixou
 	return NULL;
 }
 
+/* Acquire all free space of mixout sink, unless some mixin already did it */
+static void mixout_acquire_buf(struct mixout_data *mixout_data, struct sof_sink *sink)
+{
+	size_t free_bytes;
+	size_t buf_size;
+
+	if (mixout_data->acquired_buf.ptr)
+		return;
+
+	free_bytes = sink_get_free_size(sink);
+	sink_get_buffer(sink, free_bytes, &mixout_data->acquired_buf.ptr,
+			&mixout_data->acquired_buf.buf_start, &buf_size);
+	mixout_data->acquired_buf.buf_end =
+		(uint8_t *)mixout_data->acquired_buf.buf_start + buf_size;
+	mixout_data->acquired_buf_free_frames = free_bytes / sink_get_frame_bytes(sink);
+}
+
+/* Start a ramp from the current gain to the new one, it lasts CONFIG_MIXIN_MIXOUT_GAIN_RAMP_MS */
+static void mixin_gain_set(struct processing_module *mod,
+			   struct mixin_sink_config *sink_config, uint16_t gain)
+{
+	uint32_t rate = mod->priv.cfg.base_cfg.audio_fmt.sampling_frequency;
+	int ramp_chunks = rate * CONFIG_MIXIN_MIXOUT_GAIN_RAMP_MS /
+		(1000 * MIXIN_GAIN_RAMP_CHUNK_FRAMES);
+	uint32_t flags;
+
+	/* The gain is used by mixin or mixout processing on this core, keep it
+	 * from seeing a partially updated ramp.
+	 */
+	irq_local_disable(flags);
+	mixin_gain_ramp_start(sink_config, gain, ramp_chunks);
+	irq_local_enable(flags);
+}
+
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+/* Returns the source of a mixin that leaves mixing of its data to mixout_process(), or NULL
+ * if the mixin mixes on its own. A mixin is pulled when it is bound to a single mixout that
+ * has a fused mixing function. The bindings are checked on each call since another mixout
+ * can be bound to a running mixin.
+ */
+static struct sof_source *mixin_get_pulled_source(struct processing_module *mixin_mod)
+{
+	struct mixin_data *md = module_get_private_data(mixin_mod);
+	struct list_item *sink_list = &mixin_mod->dev->bsink_list;
+	struct mixout_data *mixout_data;
+	struct comp_buffer *buf;
+
+	if (list_is_empty(sink_list) || sink_list->next->next != sink_list)
+		return NULL;
+
+	buf = list_first_item(sink_list, struct comp_buffer, source_list);
+	mixout_data = module_get_private_data(comp_mod(buf->sink));
+	return mixout_data->mix_n ? md->source : NULL;
+}
+#endif
+
 static int mixin_init(struct processing_module *mod)
 {
 	struct module_data *mod_data = &mod->priv;
@@ -145,6 +209,8 @@ static int mixin_init(struct processing_module *mod)
 	for (i = 0; i < MIXIN_MAX_SINKS; i++) {
 		md->sink_config[i].mixer_mode = IPC4_MIXER_NORMAL_MODE;
 		md->sink_config[i].gain = IPC4_MIXIN_UNITY_GAIN;
+		md->sink_config[i].target_gain = IPC4_MIXIN_UNITY_GAIN;
+		md->sink_config[i].ramp_frames = MIXIN_GAIN_RAMP_CHUNK_FRAMES;
 	}
 
 	mod->skip_src_buffer_invalidate = true;
@@ -191,12 +257,20 @@ static int mixout_free(struct processing_module *mod)
 	return 0;
 }
 
-static int mix(struct comp_dev *dev, const struct mixin_data *mixin_data,
-	       uint16_t sink_index, struct cir_buf_ptr *sink,
-	       uint32_t start_sample, uint32_t mixed_samples,
-	       const struct cir_buf_ptr *source, uint32_t sample_count)
+/* Mix frame_count frames of source into sink of mixout. If the gain is ramping, the mixing
+ * is split to chunks with a constant gain.
+ */
+static int mix(struct comp_dev *dev, struct mixin_data *mixin_data,
+	       uint16_t sink_index, struct sof_sink *mixout_sink, struct cir_buf_ptr *sink,
+	       uint32_t start_frame, uint32_t mixed_frames,
+	       const struct cir_buf_ptr *source, uint32_t frame_count)
 {
-	const struct mixin_sink_config *sink_config;
+	struct mixin_sink_config *sink_config;
+	uint32_t channel_count = sink_get_channels(mixout_sink);
+	uint32_t frame_bytes = sink_get_frame_bytes(mixout_sink);
+	struct cir_buf_ptr src = *source;
+	uint32_t frames;
+	mix_func mix_fn;
 
 	if (sink_index >= MIXIN_MAX_SINKS) {
 		comp_err(dev, "Sink index out of range: %u, max sinks count: %u",
@@ -206,12 +280,21 @@ static int mix(struct comp_dev *dev, const struct mixin_data *mixin_data,
 
 	sink_config = &mixin_data->sink_config[sink_index];
 
-	if (sink_config->gain == IPC4_MIXIN_UNITY_GAIN) {
-		mixin_data->mix(sink, start_sample, mixed_samples,
-			source, sample_count, sink_config->gain);
-	} else {
-		mixin_data->gain_mix(sink, start_sample, mixed_samples,
-			     source, sample_count, sink_config->gain);
+	while (frame_count) {
+		frames = MIN(frame_count, mixin_gain_frames(sink_config));
+		mix_fn = sink_config->gain == IPC4_MIXIN_UNITY_GAIN ?
+			mixin_data->mix : mixin_data->gain_mix;
+
+		/* frames past mixed_frames have no data from other mixins, they are copied */
+		mix_fn(sink, start_frame * channel_count,
+		       MAX(mixed_frames, start_frame) * channel_count,
+		       &src, frames * channel_count, sink_config->gain);
+
+		mixin_gain_advance(sink_config, frames);
+		src.ptr = cir_buf_wrap((uint8_t *)src.ptr + frames * frame_bytes,
+				       src.buf_start, src.buf_end);
+		start_frame += frames;
+		frame_count -= frames;
 	}
 
 	return 0;
@@ -285,6 +368,11 @@ static int mixin_process(struct processing_module *mod,
 		return -EINVAL;
 	}
 
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	if (mixin_get_pulled_source(mod))
+		return 0;
+#endif
+
 	/* first, let's find out how many frames can be now processed --
 	 * it is a minimal value among frames available in source buffer
 	 * and frames free in each connected mixout sink buffer.
@@ -411,18 +499,7 @@ static int mixin_process(struct processing_module *mod,
 		 * released in mixout_process(). Other connected mixins just use a pointer
 		 * stored in mixout_data->acquired_buf.
 		 */
-		if (!mixout_data->acquired_buf.ptr) {
-			struct sof_sink *sink = mixout_mod->sinks[0];
-			size_t free_bytes = sink_get_free_size(sink);
-			size_t buf_size;
-
-			sink_get_buffer(sink, free_bytes, &mixout_data->acquired_buf.ptr,
-					&mixout_data->acquired_buf.buf_start, &buf_size);
-			mixout_data->acquired_buf.buf_end =
-				(uint8_t *)mixout_data->acquired_buf.buf_start + buf_size;
-			mixout_data->acquired_buf_free_frames =
-				free_bytes / sink_get_frame_bytes(sink);
-		}
+		mixout_acquire_buf(mixout_data, mixout_mod->sinks[0]);
 
 		/* if source does not produce any data but mixin is in active state -- generate
 		 * silence instead of that source data
@@ -435,16 +512,13 @@ static int mixin_process(struct processing_module *mod,
 				mixout_data->mixed_frames * frame_bytes,
 				frames_to_copy * frame_bytes);
 		} else {
-			uint32_t channel_count = sink_get_channels(mixout_mod->sinks[0]);
-
 			/* basically, if sink buffer has no data -- copy source data there, if
 			 * sink buffer has some data (written by another mixin) mix that data
 			 * with source data.
 			 */
-			ret = mix(dev, mixin_data, sinks_ids[i], &mixout_data->acquired_buf,
-				  start_frame * channel_count,
-				  mixout_data->mixed_frames * channel_count,
-				  &source_ptr, frames_to_copy * channel_count);
+			ret = mix(dev, mixin_data, sinks_ids[i], mixout_mod->sinks[0],
+				  &mixout_data->acquired_buf, start_frame,
+				  mixout_data->mixed_frames, &source_ptr, frames_to_copy);
 			if (ret < 0)
 				return ret;
 		}
@@ -461,6 +535,67 @@ static int mixin_process(struct processing_module *mod,
 	return 0;
 }
 
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+/* Mix frames of all pulled mixin sources into mixout sink in a single pass. The data already
+ * mixed there by other mixins is one more input. frames is reduced if the sink has less space.
+ */
+static void mixout_mix_pulled(struct processing_module *mod, struct sof_source **sources,
+			      struct mixin_sink_config **sink_configs, int num_sources,
+			      uint32_t *frames)
+{
+	struct mixout_data *md = module_get_private_data(mod);
+	struct cir_buf_ptr source_ptr[MIXOUT_MAX_SOURCES];
+	uint16_t gains[MIXOUT_MAX_SOURCES];
+	struct sof_sink *sink = mod->sinks[0];
+	uint32_t channel_count = sink_get_channels(sink);
+	uint32_t frame_bytes = sink_get_frame_bytes(sink);
+	struct cir_buf_ptr sink_ptr;
+	uint32_t mixed_frames;
+	uint32_t done, n;
+	size_t buf_size;
+	int i;
+
+	mixout_acquire_buf(md, sink);
+	*frames = MIN(*frames, md->acquired_buf_free_frames);
+	if (!*frames)
+		return;
+
+	for (i = 0; i < num_sources; i++) {
+		source_get_data(sources[i], *frames * frame_bytes,
+				(const void **)&source_ptr[i].ptr,
+				(const void **)&source_ptr[i].buf_start, &buf_size);
+		source_ptr[i].buf_end = (uint8_t *)source_ptr[i].buf_start + buf_size;
+	}
+
+	/* the gains are constant within a chunk, a chunk ends where any ramp steps */
+	sink_ptr = md->acquired_buf;
+	mixed_frames = md->mixed_frames;
+	for (done = 0; done < *frames; done += n) {
+		n = *frames - done;
+		for (i = 0; i < num_sources; i++)
+			n = MIN(n, mixin_gain_frames(sink_configs[i]));
+
+		for (i = 0; i < num_sources; i++)
+			gains[i] = sink_configs[i]->gain;
+
+		md->mix_n(&sink_ptr, mixed_frames * channel_count, source_ptr, gains,
+			  num_sources, n * channel_count);
+
+		for (i = 0; i < num_sources; i++)
+			mixin_gain_advance(sink_configs[i], n);
+
+		sink_ptr.ptr = cir_buf_wrap((uint8_t *)sink_ptr.ptr + n * frame_bytes,
+					    sink_ptr.buf_start, sink_ptr.buf_end);
+		mixed_frames -= MIN(mixed_frames, n);
+	}
+
+	for (i = 0; i < num_sources; i++)
+		source_release_data(sources[i], *frames * frame_bytes);
+
+	md->mixed_frames = MAX(md->mixed_frames, *frames);
+}
+#endif
+
 /* mixout just commits its sink buffer with data already mixed by mixins */
 static int mixout_process(struct processing_module *mod,
 			  struct sof_source **sources, int num_of_sources,
@@ -471,6 +606,12 @@ static int mixout_process(struct processing_module *mod,
 	uint32_t frames_to_produce = INT32_MAX;
 	uint32_t bytes_to_produce;
 	struct pending_frames *pending_frames;
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	struct sof_source *pulled_sources[MIXOUT_MAX_SOURCES];
+	struct mixin_sink_config *pulled_configs[MIXOUT_MAX_SOURCES];
+	struct sof_source *mixin_source;
+	int num_pulled = 0;
+#endif
 	int i;
 
 	comp_dbg(dev, "mixout_process()");
@@ -497,6 +638,34 @@ static int mixout_process(struct processing_module *mod,
 						     stream);
 		mixin = unused_in_between_buf->source;
 
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+		mixin_source = mixin->state == COMP_STATE_ACTIVE ?
+			mixin_get_pulled_source(comp_mod(mixin)) : NULL;
+		if (mixin_source) {
+			struct mixin_data *mixin_data = module_get_private_data(comp_mod(mixin));
+			uint32_t sink_index = IPC4_SRC_QUEUE_ID(buf_get_id(unused_in_between_buf));
+			uint32_t avail_frames;
+
+			if (sink_index >= MIXIN_MAX_SINKS) {
+				comp_err(dev, "Sink index out of range: %u, max sinks count: %u",
+					 sink_index, MIXIN_MAX_SINKS);
+				return -EINVAL;
+			}
+
+			/* like in mixin_process() a mixin without data is mixed as silence
+			 * and does not block mixing of the others
+			 */
+			avail_frames = source_get_data_frames_available(mixin_source);
+			if (avail_frames) {
+				pulled_sources[num_pulled] = mixin_source;
+				pulled_configs[num_pulled] = &mixin_data->sink_config[sink_index];
+				num_pulled++;
+				frames_to_produce = MIN(frames_to_produce, avail_frames);
+			}
+			continue;
+		}
+#endif
+
 		pending_frames = get_mixin_pending_frames(md, mixin);
 		if (!pending_frames)
 			continue;
@@ -506,6 +675,12 @@ static int mixout_process(struct processing_module *mod,
 	}
 
 	if (frames_to_produce > 0 && frames_to_produce < INT32_MAX) {
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+		if (num_pulled)
+			mixout_mix_pulled(mod, pulled_sources, pulled_configs, num_pulled,
+					  &frames_to_produce);
+#endif
+
 		for (i = 0; i < num_of_sources; i++) {
 			const struct audio_stream *source_stream;
 			struct comp_buffer *unused_in_between_buf;
@@ -569,6 +744,9 @@ static int mixin_reset(struct processing_module *mod)
 static int mixout_reset(struct processing_module *mod)
 {
 	struct comp_dev *dev = mod->dev;
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	struct mixout_data *md = module_get_private_data(mod);
+#endif
 
 	comp_dbg(dev, "mixout_reset()");
 
@@ -601,6 +779,11 @@ static int mixout_reset(struct processing_module *mod)
 		}
 	}
 
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	/* mixins mix on their own until the mixout is prepared again */
+	md->mix_n = NULL;
+#endif
+
 	return 0;
 }
 
@@ -677,7 +860,7 @@ static int mixin_prepare(struct processing_module *mod,
 	struct mixin_data *md = module_get_private_data(mod);
 	struct comp_dev *dev = mod->dev;
 	enum sof_ipc_frame fmt;
-	int ret;
+	int ret, i;
 
 	comp_info(dev, "mixin_prepare()");
 
@@ -704,6 +887,16 @@ static int mixin_prepare(struct processing_module *mod,
 		return -EINVAL;
 	}
 
+	/* a stream starts with the gain set by host, without a ramp */
+	for (i = 0; i < MIXIN_MAX_SINKS; i++) {
+		md->sink_config[i].gain = md->sink_config[i].target_gain;
+		md->sink_config[i].ramp_frames = MIXIN_GAIN_RAMP_CHUNK_FRAMES;
+	}
+
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	md->source = sources[0];
+#endif
+
 	return 0;
 }
 
@@ -763,6 +956,13 @@ static int mixout_prepare(struct processing_module *mod,
 	for (i = 0; i < MIXOUT_MAX_SOURCES; i++)
 		md->pending_frames[i].frames = 0;
 
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+	/* without a fused function the mixins keep mixing on their own */
+	md->mix_n = mixout_get_fused_function(sink_get_valid_fmt(sinks[0]));
+	if (!md->mix_n)
+		comp_info(dev, "no fused processing function, mixins mix on their own");
+#endif
+
 	return 0;
 }
 
@@ -908,7 +1108,7 @@ static int mixin_set_config(struct processing_module *mod, uint32_t config_id,
 		gain = cfg->mixer_mode_sink_configs[i].gain;
 		if (gain > IPC4_MIXIN_UNITY_GAIN)
 			gain = IPC4_MIXIN_UNITY_GAIN;
-		mixin_data->sink_config[sink_index].gain = gain;
+		mixin_gain_set(mod, &mixin_data->sink_config[sink_index], gain);
 
 		comp_dbg(dev, "mixin_set_config(): gain 0x%x will be applied for sink %u",
 			 gain, sink_index);
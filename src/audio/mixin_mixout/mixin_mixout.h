@@ -28,6 +28,7 @@
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
 #include <sof/audio/format.h>
+#include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <stddef.h>
 
@@ -116,6 +117,71 @@ struct mix_func_map {
 
 extern const struct mix_func_map mix_func_map[];
 extern const size_t mix_count;
+
+/* A ramped gain is changed in steps, each step is applied to this many frames */
+#define MIXIN_GAIN_RAMP_CHUNK_FRAMES 16
+
+struct mixin_sink_config {
+	enum ipc4_mixer_mode mixer_mode;
+	uint32_t output_channel_count;
+	uint32_t output_channel_map;
+	/* Currently applied gain as described in struct ipc4_mixer_mode_sink_config */
+	uint16_t gain;
+	/* Gain set by host, gain is ramped towards it. Zero gain is a soft mute. */
+	uint16_t target_gain;
+	/* gain change per ramp chunk */
+	uint16_t ramp_step;
+	/* frames left in the current ramp chunk */
+	uint32_t ramp_frames;
+};
+
+/* Number of frames to mix before the gain changes, never zero */
+static inline uint32_t mixin_gain_frames(const struct mixin_sink_config *sink_config)
+{
+	if (sink_config->gain == sink_config->target_gain)
+		return UINT32_MAX;
+
+	return MAX(sink_config->ramp_frames, 1);
+}
+
+/* Account mixed frames and step the gain towards the target at the end of a ramp chunk */
+static inline void mixin_gain_advance(struct mixin_sink_config *sink_config, uint32_t frames)
+{
+	int32_t gain;
+
+	if (sink_config->gain == sink_config->target_gain)
+		return;
+
+	if (sink_config->ramp_frames > frames) {
+		sink_config->ramp_frames -= frames;
+		return;
+	}
+
+	sink_config->ramp_frames = MIXIN_GAIN_RAMP_CHUNK_FRAMES;
+	gain = sink_config->gain;
+	if (gain < sink_config->target_gain)
+		gain = MIN(gain + sink_config->ramp_step, sink_config->target_gain);
+	else
+		gain = MAX(gain - sink_config->ramp_step, sink_config->target_gain);
+
+	sink_config->gain = gain;
+}
+
+/* Ramp from the current gain to a new one in ramp_chunks steps, set it at once if zero */
+static inline void mixin_gain_ramp_start(struct mixin_sink_config *sink_config,
+					 uint16_t gain, int ramp_chunks)
+{
+	if (ramp_chunks < 1) {
+		sink_config->gain = gain;
+	} else {
+		sink_config->ramp_step = MAX(ceil_divide(ABS(gain - sink_config->gain),
+							 ramp_chunks), 1);
+		sink_config->ramp_frames = MIXIN_GAIN_RAMP_CHUNK_FRAMES;
+	}
+
+	/* the ramp starts when the target is set */
+	sink_config->target_gain = gain;
+}
 /**
  * \brief Retrievies mixin processing function.
  * \param[in] fmt  stream PCM frame format
@@ -139,4 +205,45 @@ static inline bool mixin_get_processing_functions(int fmt, mix_func *mix, mix_fu
 	return false;
 }
 
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+/**
+ * \brief mixout fused processing function interface
+ *
+ * Accumulates sample_count samples of all num_sources sources, each scaled by
+ * its gain, into sink with a single saturation per sample. The first
+ * mixed_samples samples already in sink are one more input to the sum, the
+ * rest of the sink is overwritten. The source pointers are advanced past the
+ * mixed samples.
+ */
+typedef void (*mix_n_func)(struct cir_buf_ptr *sink, int32_t mixed_samples,
+			   struct cir_buf_ptr *sources, const uint16_t *gains,
+			   int num_sources, int32_t sample_count);
+
+/**
+ * @brief mixout fused processing functions map.
+ */
+struct mix_n_func_map {
+	uint16_t frame_fmt;	/* frame format */
+	mix_n_func mix_n;	/* fused N-input mixing func with gain support */
+};
+
+extern const struct mix_n_func_map mix_n_func_map[];
+extern const size_t mix_n_count;
+
+/**
+ * \brief Retrieves mixout fused processing function.
+ * \param[in] fmt  stream PCM frame format
+ */
+static inline mix_n_func mixout_get_fused_function(int fmt)
+{
+	int i;
+
+	for (i = 0; i < mix_n_count; i++)
+		if (fmt == mix_n_func_map[i].frame_fmt)
+			return mix_n_func_map[i].mix_n;
+
+	return NULL;
+}
+#endif
+
 #endif	/* __SOF_IPC4_MIXIN_MIXOUT_H__ */
@@ -298,3 +298,190 @@ const struct mix_func_map mix_func_map[] = {
 const size_t mix_count = ARRAY_SIZE(mix_func_map);
 
 #endif
+
+#if CONFIG_MIXIN_MIXOUT_FUSED_MIX
+
+/* Samples accumulated at a time by the fused mixing functions */
+#define MIX_N_BLOCK_SAMPLES	32
+
+/* Limit n to the contiguous samples left in each source and return the wrapped
+ * source pointers back to sources[].
+ */
+static int32_t mix_n_block_size(struct cir_buf_ptr *sources, int num_sources,
+				int32_t n, size_t sample_bytes)
+{
+	int32_t nmax;
+	int j;
+
+	for (j = 0; j < num_sources; j++) {
+		sources[j].ptr = cir_buf_wrap(sources[j].ptr, sources[j].buf_start,
+					      sources[j].buf_end);
+		nmax = ((uint8_t *)sources[j].buf_end - (uint8_t *)sources[j].ptr) /
+			sample_bytes;
+		n = MIN(n, nmax);
+	}
+
+	return n;
+}
+
+#if CONFIG_FORMAT_S16LE
+static void mix_n_s16(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int num_sources, int32_t sample_count)
+{
+	int32_t acc[MIX_N_BLOCK_SAMPLES];
+	int32_t left_samples, n, nmax, i;
+	int16_t *dst = sink->ptr;
+	int16_t *src;
+	int j;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		nmax = (int16_t *)sink->buf_end - dst;
+		n = MIN(left_samples, nmax);
+		n = MIN(n, MIX_N_BLOCK_SAMPLES);
+		n = mix_n_block_size(sources, num_sources, n, sizeof(int16_t));
+
+		if (mixed_samples > 0) {
+			n = MIN(n, mixed_samples);
+			mixed_samples -= n;
+			for (i = 0; i < n; i++)
+				acc[i] = dst[i];
+		} else {
+			memset(acc, 0, n * sizeof(acc[0]));
+		}
+
+		for (j = 0; j < num_sources; j++) {
+			src = sources[j].ptr;
+			if (gains[j] == IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += src[i];
+			} else {
+				for (i = 0; i < n; i++)
+					acc[i] += q_mults_16x16(src[i], gains[j],
+								IPC4_MIXIN_GAIN_SHIFT);
+			}
+			sources[j].ptr = src + n;
+		}
+
+		for (i = 0; i < n; i++)
+			dst[i] = sat_int16(acc[i]);
+
+		dst += n;
+	}
+}
+#endif	/* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static void mix_n_s24(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int num_sources, int32_t sample_count)
+{
+	int32_t acc[MIX_N_BLOCK_SAMPLES];
+	int32_t left_samples, n, nmax, i;
+	int32_t *dst = sink->ptr;
+	int32_t *src;
+	int j;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		nmax = (int32_t *)sink->buf_end - dst;
+		n = MIN(left_samples, nmax);
+		n = MIN(n, MIX_N_BLOCK_SAMPLES);
+		n = mix_n_block_size(sources, num_sources, n, sizeof(int32_t));
+
+		if (mixed_samples > 0) {
+			n = MIN(n, mixed_samples);
+			mixed_samples -= n;
+			for (i = 0; i < n; i++)
+				acc[i] = sign_extend_s24(dst[i]);
+		} else {
+			memset(acc, 0, n * sizeof(acc[0]));
+		}
+
+		/* at most 8 inputs of 24 bits, the sum fits in 32 bits */
+		for (j = 0; j < num_sources; j++) {
+			src = sources[j].ptr;
+			if (gains[j] == IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += sign_extend_s24(src[i]);
+			} else {
+				for (i = 0; i < n; i++)
+					acc[i] += (int32_t)q_mults_32x32(sign_extend_s24(src[i]),
+									 gains[j],
+									 IPC4_MIXIN_GAIN_SHIFT);
+			}
+			sources[j].ptr = src + n;
+		}
+
+		for (i = 0; i < n; i++)
+			dst[i] = sat_int24(acc[i]);
+
+		dst += n;
+	}
+}
+#endif	/* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void mix_n_s32(struct cir_buf_ptr *sink, int32_t mixed_samples,
+		      struct cir_buf_ptr *sources, const uint16_t *gains,
+		      int num_sources, int32_t sample_count)
+{
+	int64_t acc[MIX_N_BLOCK_SAMPLES];
+	int32_t left_samples, n, nmax, i;
+	int32_t *dst = sink->ptr;
+	int32_t *src;
+	int j;
+
+	for (left_samples = sample_count; left_samples > 0; left_samples -= n) {
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		nmax = (int32_t *)sink->buf_end - dst;
+		n = MIN(left_samples, nmax);
+		n = MIN(n, MIX_N_BLOCK_SAMPLES);
+		n = mix_n_block_size(sources, num_sources, n, sizeof(int32_t));
+
+		if (mixed_samples > 0) {
+			n = MIN(n, mixed_samples);
+			mixed_samples -= n;
+			for (i = 0; i < n; i++)
+				acc[i] = dst[i];
+		} else {
+			memset(acc, 0, n * sizeof(acc[0]));
+		}
+
+		for (j = 0; j < num_sources; j++) {
+			src = sources[j].ptr;
+			if (gains[j] == IPC4_MIXIN_UNITY_GAIN) {
+				for (i = 0; i < n; i++)
+					acc[i] += src[i];
+			} else {
+				for (i = 0; i < n; i++)
+					acc[i] += q_mults_32x32(src[i], gains[j],
+								IPC4_MIXIN_GAIN_SHIFT);
+			}
+			sources[j].ptr = src + n;
+		}
+
+		for (i = 0; i < n; i++)
+			dst[i] = sat_int32(acc[i]);
+
+		dst += n;
+	}
+}
+#endif	/* CONFIG_FORMAT_S32LE */
+
+const struct mix_n_func_map mix_n_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, mix_n_s16 },
+#endif
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, mix_n_s24 },
+#endif
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, mix_n_s32 }
+#endif
+};
+
+const size_t mix_n_count = ARRAY_SIZE(mix_n_func_map);
+
+#endif	/* CONFIG_MIXIN_MIXOUT_FUSED_MIX */
@@ -310,6 +310,100 @@ static int multiband_drc_get_config(struct processing_module *mod,
 	return multiband_drc_get_ipc_config(mod, cdata, fragment_size);
 }
 
+/* Map each band to the index of its sink in output buffers, these follow
+ * the bsink_list order.
+ */
+static int multiband_drc_map_band_sinks(struct processing_module *mod)
+{
+	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
+	struct comp_dev *dev = mod->dev;
+	struct comp_buffer *sinkb;
+	struct list_item *sink_list;
+	uint32_t mapped = 0;
+	int band;
+	int i = 0;
+
+	list_for_item(sink_list, &dev->bsink_list) {
+		sinkb = container_of(sink_list, struct comp_buffer, source_list);
+		band = multiband_drc_get_sink_band(mod, sinkb);
+		if (band < 0 || band >= cd->num_sinks || (mapped & BIT(band))) {
+			comp_err(dev, "multiband_drc_map_band_sinks(), invalid band %d for sink %d",
+				 band, i);
+			return -EINVAL;
+		}
+
+		cd->band_sink[band] = i++;
+		mapped |= BIT(band);
+	}
+
+	return 0;
+}
+
+/* Set up the DRC and select the processing functions for the current blob,
+ * switch state and sinks. Called from prepare and again from process when
+ * the blob or the switch changes at run-time.
+ */
+static int multiband_drc_configure(struct processing_module *mod, int channels, int rate)
+{
+	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
+	struct comp_dev *dev = mod->dev;
+	int ret;
+
+	cd->func_enabled = cd->process_enabled;
+	if (cd->config && cd->process_enabled) {
+		if (cd->num_sinks > 1 && cd->num_sinks != cd->config->num_bands) {
+			comp_err(dev, "multiband_drc_configure(), %d sinks do not match %d bands",
+				 cd->num_sinks, cd->config->num_bands);
+			return -EINVAL;
+		}
+
+		cd->crossover_split = crossover_find_split_func(cd->config->num_bands);
+		if (!cd->crossover_split) {
+			comp_err(dev, "multiband_drc_configure(), No crossover_split for band num %i",
+				 cd->config->num_bands);
+			return -EINVAL;
+		}
+
+		cd->multiband_drc_func = multiband_drc_find_proc_func(cd->source_format);
+		if (!cd->multiband_drc_func) {
+			comp_err(dev, "multiband_drc_configure(), No proc func");
+			return -EINVAL;
+		}
+
+		ret = multiband_drc_setup(mod, channels, rate);
+		if (ret < 0) {
+			comp_err(dev, "multiband_drc_configure() error: multiband_drc_setup failed.");
+			return ret;
+		}
+	} else {
+		comp_info(dev, "multiband_drc_configure(), DRC is in passthrough mode");
+		cd->multiband_drc_func = multiband_drc_find_proc_func_pass(cd->source_format);
+		if (!cd->multiband_drc_func) {
+			comp_err(dev, "multiband_drc_configure(), No proc func passthrough");
+			return -EINVAL;
+		}
+	}
+
+	cd->band_outputs = cd->num_sinks > 1;
+	if (!cd->band_outputs)
+		return 0;
+
+	comp_info(dev, "multiband_drc_configure(), band outputs mode with %d sinks",
+		  cd->num_sinks);
+	if (cd->config && cd->config->enable_emp_deemp)
+		comp_warn(dev, "multiband_drc_configure(), emphasis is bypassed with band outputs");
+
+	cd->multiband_drc_bands_func =
+		multiband_drc_find_bands_func(cd->source_format,
+					      !(cd->config && cd->process_enabled));
+	if (!cd->multiband_drc_bands_func) {
+		comp_err(dev, "multiband_drc_configure(), No band outputs func");
+		return -EINVAL;
+	}
+
+	return multiband_drc_map_band_sinks(mod);
+}
+
 static int multiband_drc_process(struct processing_module *mod,
 				 struct input_stream_buffer *input_buffers, int num_input_buffers,
 				 struct output_stream_buffer *output_buffers,
@@ -320,21 +414,49 @@ static int multiband_drc_process(struct processing_module *mod,
 	struct audio_stream *source = input_buffers[0].data;
 	struct audio_stream *sink = output_buffers[0].data;
 	int frames = input_buffers[0].size;
+	uint32_t processed_bytes;
+	bool update = false;
 	int ret;
+	int i;
 
 	comp_dbg(dev, "multiband_drc_process()");
 
-	/* Check for changed configuration */
+	/* Check for changed configuration or switch, the processing functions
+	 * and the band count check depend on both.
+	 */
 	if (comp_is_new_data_blob_available(cd->model_handler)) {
 		cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
-		ret = multiband_drc_setup(mod, (int16_t)audio_stream_get_channels(sink),
-					  audio_stream_get_rate(sink));
+		update = true;
+	}
+
+	if (update || cd->func_enabled != cd->process_enabled) {
+		ret = multiband_drc_configure(mod, audio_stream_get_channels(source),
+					      audio_stream_get_rate(source));
 		if (ret < 0) {
-			comp_err(dev, "multiband_drc_process(), failed DRC setup");
-			return ret;
+			/* Reject the blob, pass audio through until a valid one arrives */
+			comp_err(dev, "multiband_drc_process(), blob rejected, passthrough");
+			cd->config = NULL;
+			ret = multiband_drc_configure(mod, audio_stream_get_channels(source),
+						      audio_stream_get_rate(source));
+			if (ret < 0)
+				return ret;
 		}
 	}
 
+	if (cd->band_outputs) {
+		/* One sink per band, the frames count from module adapter is
+		 * checked against all sinks.
+		 */
+		cd->multiband_drc_bands_func(mod, source, output_buffers, num_output_buffers,
+					     frames);
+		processed_bytes = frames * audio_stream_frame_bytes(source);
+		input_buffers[0].consumed = processed_bytes;
+		for (i = 0; i < num_output_buffers; i++)
+			output_buffers[i].size = processed_bytes;
+
+		return 0;
+	}
+
 	cd->multiband_drc_func(mod, source, sink, frames);
 
 	/* calc new free and available */
@@ -349,6 +471,8 @@ static int multiband_drc_prepare(struct processing_module *mod,
 	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
 	struct comp_dev *dev = mod->dev;
 	struct comp_buffer *sourceb;
+	struct comp_buffer *sinkb;
+	struct list_item *sink_list;
 	int channels;
 	int rate;
 	int ret = 0;
@@ -359,7 +483,10 @@ static int multiband_drc_prepare(struct processing_module *mod,
 	if (ret < 0)
 		return ret;
 
-	/* DRC component will only ever have 1 source and 1 sink buffer */
+	/* DRC component will only ever have 1 source buffer. It has either
+	 * 1 sink buffer or one sink buffer per band in band outputs mode.
+	 */
+	mod->max_sinks = SOF_MULTIBAND_DRC_MAX_BANDS;
 	sourceb = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
 
 	/* get source data format */
@@ -367,39 +494,27 @@ static int multiband_drc_prepare(struct processing_module *mod,
 	channels = audio_stream_get_channels(&sourceb->stream);
 	rate = audio_stream_get_rate(&sourceb->stream);
 
-	/* Initialize DRC */
-	comp_dbg(dev, "multiband_drc_prepare(), source_format=%d, sink_format=%d",
-		 cd->source_format, cd->source_format);
-	cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
-	if (cd->config && cd->process_enabled) {
-		ret = multiband_drc_setup(mod, channels, rate);
-		if (ret < 0) {
-			comp_err(dev, "multiband_drc_prepare() error: multiband_drc_setup failed.");
-			return ret;
-		}
-
-		cd->multiband_drc_func = multiband_drc_find_proc_func(cd->source_format);
-		if (!cd->multiband_drc_func) {
-			comp_err(dev, "multiband_drc_prepare(), No proc func");
+	/* The processing functions write the source format to every sink */
+	cd->num_sinks = 0;
+	list_for_item(sink_list, &dev->bsink_list) {
+		sinkb = container_of(sink_list, struct comp_buffer, source_list);
+		if (audio_stream_get_frm_fmt(&sinkb->stream) != cd->source_format ||
+		    audio_stream_get_channels(&sinkb->stream) != channels) {
+			comp_err(dev, "multiband_drc_prepare(), sink %d format %d ch %d, source %d ch %d",
+				 cd->num_sinks, audio_stream_get_frm_fmt(&sinkb->stream),
+				 audio_stream_get_channels(&sinkb->stream), cd->source_format,
+				 channels);
 			return -EINVAL;
 		}
 
-		cd->crossover_split = crossover_find_split_func(cd->config->num_bands);
-		if (!cd->crossover_split) {
-			comp_err(dev, "multiband_drc_prepare(), No crossover_split for band num %i",
-				 cd->config->num_bands);
-			return -EINVAL;
-		}
-	} else {
-		comp_info(dev, "multiband_drc_prepare(), DRC is in passthrough mode");
-		cd->multiband_drc_func = multiband_drc_find_proc_func_pass(cd->source_format);
-		if (!cd->multiband_drc_func) {
-			comp_err(dev, "multiband_drc_prepare(), No proc func passthrough");
-			return -EINVAL;
-		}
+		cd->num_sinks++;
 	}
 
-	return ret;
+	/* Initialize DRC */
+	comp_dbg(dev, "multiband_drc_prepare(), source_format=%d, sink_format=%d",
+		 cd->source_format, cd->source_format);
+	cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
+	return multiband_drc_configure(mod, channels, rate);
 }
 
 static int multiband_drc_reset(struct processing_module *mod)
@@ -413,6 +528,9 @@ static int multiband_drc_reset(struct processing_module *mod)
 	cd->source_format = 0;
 	cd->multiband_drc_func = NULL;
 	cd->crossover_split = NULL;
+	cd->num_sinks = 0;
+	cd->band_outputs = false;
+	cd->multiband_drc_bands_func = NULL;
 
 	return 0;
 }
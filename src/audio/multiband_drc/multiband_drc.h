@@ -33,6 +33,20 @@ typedef void (*multiband_drc_func)(const struct processing_module *mod,
 				   struct audio_stream *sink,
 				   uint32_t frames);
 
+/**
+ * Band outputs mode: when the component is bound to one sink per band, the
+ * compressed bands are not summed back. Band n is written to the sink that
+ * multiband_drc_get_sink_band() maps to it, so the Multiband DRC can directly
+ * feed the drivers of an active speaker, replacing a Crossover that would
+ * otherwise split the signal a second time. The emphasis and deemphasis
+ * filters are bypassed in this mode.
+ */
+typedef void (*multiband_drc_bands_func)(const struct processing_module *mod,
+					 const struct audio_stream *source,
+					 struct output_stream_buffer *sinks,
+					 int num_sinks,
+					 uint32_t frames);
+
 /* Multiband DRC component private data */
 struct multiband_drc_comp_data {
 	struct multiband_drc_state state;        /**< compressor state */
@@ -43,6 +57,11 @@ struct multiband_drc_comp_data {
 	bool process_enabled;                    /**< true if component is enabled */
 	multiband_drc_func multiband_drc_func;   /**< processing function */
 	crossover_split crossover_split;         /**< crossover n-way split func */
+	bool func_enabled;                       /**< process_enabled of selected funcs */
+	int num_sinks;                           /**< number of connected sinks */
+	bool band_outputs;                       /**< true if each band has own sink */
+	multiband_drc_bands_func multiband_drc_bands_func; /**< band outputs func */
+	int band_sink[SOF_MULTIBAND_DRC_MAX_BANDS]; /**< output buffer index of band */
 };
 
 struct multiband_drc_proc_fnmap {
@@ -54,6 +73,15 @@ extern const struct multiband_drc_proc_fnmap multiband_drc_proc_fnmap[];
 extern const struct multiband_drc_proc_fnmap multiband_drc_proc_fnmap_pass[];
 extern const size_t multiband_drc_proc_fncount;
 
+struct multiband_drc_bands_fnmap {
+	enum sof_ipc_frame frame_fmt;
+	multiband_drc_bands_func multiband_drc_bands_func;
+};
+
+extern const struct multiband_drc_bands_fnmap multiband_drc_bands_fnmap[];
+extern const struct multiband_drc_bands_fnmap multiband_drc_bands_fnmap_pass[];
+extern const size_t multiband_drc_bands_fncount;
+
 /**
  * \brief Returns Multiband DRC processing function.
  */
@@ -84,6 +112,24 @@ static inline multiband_drc_func multiband_drc_find_proc_func_pass(enum sof_ipc_
 	return NULL;
 }
 
+/**
+ * \brief Returns Multiband DRC band outputs processing function.
+ */
+static inline multiband_drc_bands_func
+	multiband_drc_find_bands_func(enum sof_ipc_frame src_fmt, bool pass)
+{
+	const struct multiband_drc_bands_fnmap *map = pass ? multiband_drc_bands_fnmap_pass :
+							     multiband_drc_bands_fnmap;
+	int i;
+
+	/* Find suitable processing function from map */
+	for (i = 0; i < multiband_drc_bands_fncount; i++)
+		if (src_fmt == map[i].frame_fmt)
+			return map[i].multiband_drc_bands_func;
+
+	return NULL;
+}
+
 static inline void multiband_drc_iir_reset_state_ch(struct iir_state_df2t *iir)
 {
 	rfree(iir->coef);
@@ -100,6 +146,7 @@ int multiband_drc_set_ipc_config(struct processing_module *mod, uint32_t param_i
 int multiband_drc_get_ipc_config(struct processing_module *mod, struct sof_ipc_ctrl_data *cdata,
 				 size_t fragment_size);
 int multiband_drc_params(struct processing_module *mod);
+int multiband_drc_get_sink_band(struct processing_module *mod, struct comp_buffer *sink);
 
 #ifdef UNIT_TEST
 void sys_comp_module_multiband_drc_interface_init(void);
@@ -403,6 +403,260 @@ static void multiband_drc_s32_default(const struct processing_module *mod,
 }
 #endif /* CONFIG_FORMAT_S32LE */
 
+static void multiband_drc_bands_pass(const struct processing_module *mod,
+				     const struct audio_stream *source,
+				     struct output_stream_buffer *sinks,
+				     int num_sinks,
+				     uint32_t frames)
+{
+	int samples = audio_stream_get_channels(source) * frames;
+	int i;
+
+	for (i = 0; i < num_sinks; i++)
+		audio_stream_copy(source, 0, sinks[i].data, 0, samples);
+}
+
+/* Band outputs variants of the default functions. The input is split and
+ * compressed as above, but instead of mixing the bands and running the
+ * deemphasis, the output of DRC n is written to the sink mapped to band n:
+ *
+ *                                         o-[]-> DRC0 -[]-> sink0
+ *                                         |
+ *                               3-WAY     |
+ *    source -[]--------------> CROSSOVER -o-[]-> DRC1 -[]-> sink1
+ *                                         |
+ *                                         o-[]-> DRC2 -[]-> sink2
+ */
+#if CONFIG_FORMAT_S16LE
+static void multiband_drc_s16_bands(const struct processing_module *mod,
+				    const struct audio_stream *source,
+				    struct output_stream_buffer *sinks,
+				    int num_sinks,
+				    uint32_t frames)
+{
+	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
+	struct multiband_drc_state *state = &cd->state;
+	struct audio_stream *sink[SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_src[PLATFORM_MAX_CHANNELS];
+	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t *band_buf_drc_src;
+	int32_t *band_buf_drc_sink;
+	int16_t *x = audio_stream_get_rptr(source);
+	int16_t *y[SOF_MULTIBAND_DRC_MAX_BANDS];
+	int band;
+	int nbuf;
+	int npcm;
+	int ch;
+	int i;
+	int nch = audio_stream_get_channels(source);
+	int nband = cd->config->num_bands;
+	int samples = frames * nch;
+
+	for (band = 0; band < nband; band++) {
+		sink[band] = sinks[cd->band_sink[band]].data;
+		y[band] = audio_stream_get_wptr(sink[band]);
+	}
+
+	while (samples) {
+		nbuf = audio_stream_samples_without_wrap_s16(source, x);
+		npcm = MIN(samples, nbuf);
+		for (band = 0; band < nband; band++) {
+			nbuf = audio_stream_samples_without_wrap_s16(sink[band], y[band]);
+			npcm = MIN(npcm, nbuf);
+		}
+
+		for (i = 0; i < npcm; i += nch) {
+			for (ch = 0; ch < nch; ch++) {
+				buf_src[ch] = *x << 16;
+				x++;
+			}
+
+			multiband_drc_process_emp_crossover(state, cd->crossover_split,
+							    buf_src, buf_drc_src, 0, nch, nband);
+
+			band_buf_drc_src = buf_drc_src;
+			band_buf_drc_sink = buf_drc_sink;
+			for (band = 0; band < nband; ++band) {
+				multiband_drc_s16_process_drc(&state->drc[band],
+							      &cd->config->drc_coef[band],
+							      band_buf_drc_src, band_buf_drc_sink,
+							      nch);
+				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
+				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+			}
+
+			band_buf_drc_sink = buf_drc_sink;
+			for (band = 0; band < nband; band++) {
+				for (ch = 0; ch < nch; ch++) {
+					*y[band] = sat_int16(Q_SHIFT_RND(band_buf_drc_sink[ch],
+									 31, 15));
+					y[band]++;
+				}
+				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+			}
+		}
+		samples -= npcm;
+		x = audio_stream_wrap(source, x);
+		for (band = 0; band < nband; band++)
+			y[band] = audio_stream_wrap(sink[band], y[band]);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static void multiband_drc_s24_bands(const struct processing_module *mod,
+				    const struct audio_stream *source,
+				    struct output_stream_buffer *sinks,
+				    int num_sinks,
+				    uint32_t frames)
+{
+	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
+	struct multiband_drc_state *state = &cd->state;
+	struct audio_stream *sink[SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_src[PLATFORM_MAX_CHANNELS];
+	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t *band_buf_drc_src;
+	int32_t *band_buf_drc_sink;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y[SOF_MULTIBAND_DRC_MAX_BANDS];
+	int band;
+	int nbuf;
+	int npcm;
+	int ch;
+	int i;
+	int nch = audio_stream_get_channels(source);
+	int nband = cd->config->num_bands;
+	int samples = frames * nch;
+
+	for (band = 0; band < nband; band++) {
+		sink[band] = sinks[cd->band_sink[band]].data;
+		y[band] = audio_stream_get_wptr(sink[band]);
+	}
+
+	while (samples) {
+		nbuf = audio_stream_samples_without_wrap_s24(source, x);
+		npcm = MIN(samples, nbuf);
+		for (band = 0; band < nband; band++) {
+			nbuf = audio_stream_samples_without_wrap_s24(sink[band], y[band]);
+			npcm = MIN(npcm, nbuf);
+		}
+
+		for (i = 0; i < npcm; i += nch) {
+			for (ch = 0; ch < nch; ch++) {
+				buf_src[ch] = *x << 8;
+				x++;
+			}
+
+			multiband_drc_process_emp_crossover(state, cd->crossover_split,
+							    buf_src, buf_drc_src, 0, nch, nband);
+
+			band_buf_drc_src = buf_drc_src;
+			band_buf_drc_sink = buf_drc_sink;
+			for (band = 0; band < nband; ++band) {
+				multiband_drc_s32_process_drc(&state->drc[band],
+							      &cd->config->drc_coef[band],
+							      band_buf_drc_src, band_buf_drc_sink,
+							      nch);
+				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
+				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+			}
+
+			band_buf_drc_sink = buf_drc_sink;
+			for (band = 0; band < nband; band++) {
+				for (ch = 0; ch < nch; ch++) {
+					*y[band] = sat_int24(Q_SHIFT_RND(band_buf_drc_sink[ch],
+									 31, 23));
+					y[band]++;
+				}
+				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+			}
+		}
+		samples -= npcm;
+		x = audio_stream_wrap(source, x);
+		for (band = 0; band < nband; band++)
+			y[band] = audio_stream_wrap(sink[band], y[band]);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void multiband_drc_s32_bands(const struct processing_module *mod,
+				    const struct audio_stream *source,
+				    struct output_stream_buffer *sinks,
+				    int num_sinks,
+				    uint32_t frames)
+{
+	struct multiband_drc_comp_data *cd = module_get_private_data(mod);
+	struct multiband_drc_state *state = &cd->state;
+	struct audio_stream *sink[SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_src[PLATFORM_MAX_CHANNELS];
+	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t *band_buf_drc_src;
+	int32_t *band_buf_drc_sink;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y[SOF_MULTIBAND_DRC_MAX_BANDS];
+	int band;
+	int nbuf;
+	int npcm;
+	int ch;
+	int i;
+	int nch = audio_stream_get_channels(source);
+	int nband = cd->config->num_bands;
+	int samples = frames * nch;
+
+	for (band = 0; band < nband; band++) {
+		sink[band] = sinks[cd->band_sink[band]].data;
+		y[band] = audio_stream_get_wptr(sink[band]);
+	}
+
+	while (samples) {
+		nbuf = audio_stream_samples_without_wrap_s32(source, x);
+		npcm = MIN(samples, nbuf);
+		for (band = 0; band < nband; band++) {
+			nbuf = audio_stream_samples_without_wrap_s32(sink[band], y[band]);
+			npcm = MIN(npcm, nbuf);
+		}
+
+		for (i = 0; i < npcm; i += nch) {
+			for (ch = 0; ch < nch; ch++) {
+				buf_src[ch] = *x;
+				x++;
+			}
+
+			multiband_drc_process_emp_crossover(state, cd->crossover_split,
+							    buf_src, buf_drc_src, 0, nch, nband);
+
+			band_buf_drc_src = buf_drc_src;
+			band_buf_drc_sink = buf_drc_sink;
+			for (band = 0; band < nband; ++band) {
+				multiband_drc_s32_process_drc(&state->drc[band],
+							      &cd->config->drc_coef[band],
+							      band_buf_drc_src, band_buf_drc_sink,
+							      nch);
+				band_buf_drc_src += PLATFORM_MAX_CHANNELS;
+				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+			}
+
+			band_buf_drc_sink = buf_drc_sink;
+			for (band = 0; band < nband; band++) {
+				for (ch = 0; ch < nch; ch++) {
+					*y[band] = band_buf_drc_sink[ch];
+					y[band]++;
+				}
+				band_buf_drc_sink += PLATFORM_MAX_CHANNELS;
+			}
+		}
+		samples -= npcm;
+		x = audio_stream_wrap(source, x);
+		for (band = 0; band < nband; band++)
+			y[band] = audio_stream_wrap(sink[band], y[band]);
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
 const struct multiband_drc_proc_fnmap multiband_drc_proc_fnmap[] = {
 /* { SOURCE_FORMAT , PROCESSING FUNCTION } */
 #if CONFIG_FORMAT_S16LE
@@ -434,3 +688,35 @@ const struct multiband_drc_proc_fnmap multiband_drc_proc_fnmap_pass[] = {
 };
 
 const size_t multiband_drc_proc_fncount = ARRAY_SIZE(multiband_drc_proc_fnmap);
+
+const struct multiband_drc_bands_fnmap multiband_drc_bands_fnmap[] = {
+/* { SOURCE_FORMAT , PROCESSING FUNCTION } */
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, multiband_drc_s16_bands },
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, multiband_drc_s24_bands },
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, multiband_drc_s32_bands },
+#endif /* CONFIG_FORMAT_S32LE */
+};
+
+const struct multiband_drc_bands_fnmap multiband_drc_bands_fnmap_pass[] = {
+/* { SOURCE_FORMAT , PROCESSING FUNCTION } */
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, multiband_drc_bands_pass },
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, multiband_drc_bands_pass },
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, multiband_drc_bands_pass },
+#endif /* CONFIG_FORMAT_S32LE */
+};
+
+const size_t multiband_drc_bands_fncount = ARRAY_SIZE(multiband_drc_bands_fnmap);
@@ -100,3 +100,21 @@ int multiband_drc_params(struct processing_module *mod)
 	return 0;
 }
 
+/* IPC3 has no output pins, the bands are assigned to the sinks in the
+ * order of their buffer ids, i.e. the order the topology declares them.
+ */
+int multiband_drc_get_sink_band(struct processing_module *mod, struct comp_buffer *sink)
+{
+	struct comp_buffer *buffer;
+	struct list_item *sink_list;
+	int band = 0;
+
+	list_for_item(sink_list, &mod->dev->bsink_list) {
+		buffer = container_of(sink_list, struct comp_buffer, source_list);
+		if (buf_get_id(buffer) < buf_get_id(sink))
+			band++;
+	}
+
+	return band;
+}
+
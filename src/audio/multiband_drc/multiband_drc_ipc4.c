@@ -11,6 +11,7 @@
 #include <module/module/interface.h>
 #include <sof/audio/component.h>
 #include <ipc4/header.h>
+#include <ipc4/module.h>
 #include <sof/audio/data_blob.h>
 #include <ipc/control.h>
 #include <ipc/stream.h>
@@ -77,6 +78,7 @@ int multiband_drc_params(struct processing_module *mod)
 	struct sof_ipc_stream_params comp_params;
 	struct comp_dev *dev = mod->dev;
 	struct comp_buffer *sinkb;
+	struct list_item *sink_list;
 	enum sof_ipc_frame valid_fmt, frame_fmt;
 	int i, ret;
 
@@ -98,9 +100,21 @@ int multiband_drc_params(struct processing_module *mod)
 		comp_params.chmap[i] = (mod->priv.cfg.base_cfg.audio_fmt.ch_map >> i * 4) & 0xf;
 
 	component_set_nearest_period_frames(dev, comp_params.rate);
-	sinkb = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
-	ret = buffer_set_params(sinkb, &comp_params, true);
 
-	return ret;
+	/* In band outputs mode all sinks carry the source format */
+	list_for_item(sink_list, &dev->bsink_list) {
+		sinkb = container_of(sink_list, struct comp_buffer, source_list);
+		ret = buffer_set_params(sinkb, &comp_params, true);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* The band of a sink is the output pin it is bound to */
+int multiband_drc_get_sink_band(struct processing_module *mod, struct comp_buffer *sink)
+{
+	return IPC4_SRC_QUEUE_ID(buf_get_id(sink));
 }
 
@@ -180,52 +180,6 @@ static struct mux_look_up *get_lookup_table(struct comp_dev *dev, struct comp_da
 	return 0;
 }
 
-static void mux_prepare_active_look_up(struct comp_data *cd,
-				       struct audio_stream *sink,
-				       const struct audio_stream **sources)
-{
-	const struct audio_stream *source;
-	int elem;
-	int active_elem = 0;
-
-	/* init pointers */
-	for (elem = 0; elem < cd->lookup[0].num_elems; elem++) {
-		source = sources[cd->lookup[0].copy_elem[elem].stream_id];
-		if (!source)
-			continue;
-
-		if (cd->lookup[0].copy_elem[elem].in_ch >= audio_stream_get_channels(source) ||
-		    cd->lookup[0].copy_elem[elem].out_ch >= audio_stream_get_channels(sink))
-			continue;
-
-		cd->active_lookup.copy_elem[active_elem] = cd->lookup[0].copy_elem[elem];
-		active_elem++;
-	}
-
-	cd->active_lookup.num_elems = active_elem;
-}
-
-static void demux_prepare_active_look_up(struct comp_data *cd,
-					 struct audio_stream *sink,
-					 const struct audio_stream *source,
-					 struct mux_look_up *look_up)
-{
-	int elem;
-	int active_elem = 0;
-
-	/* init pointers */
-	for (elem = 0; elem < look_up->num_elems; elem++) {
-		if (look_up->copy_elem[elem].in_ch >= audio_stream_get_channels(source) ||
-		    look_up->copy_elem[elem].out_ch >= audio_stream_get_channels(sink))
-			continue;
-
-		cd->active_lookup.copy_elem[active_elem] = look_up->copy_elem[elem];
-		active_elem++;
-	}
-
-	cd->active_lookup.num_elems = active_elem;
-}
-
 /* process and copy stream data from source to sink buffers */
 static int demux_process(struct processing_module *mod,
 			 struct input_stream_buffer *input_buffers, int num_input_buffers,
@@ -237,9 +191,11 @@ static int demux_process(struct processing_module *mod,
 	struct comp_buffer *sink;
 	struct audio_stream *sinks_stream[MUX_MAX_STREAMS] = { NULL };
 	struct mux_look_up *look_ups[MUX_MAX_STREAMS] = { NULL };
+	const struct audio_stream *source = input_buffers[0].data;
 	int frames;
 	int sink_bytes;
 	int source_bytes;
+	int ret;
 	int i;
 
 	comp_dbg(dev, "demux_process()");
@@ -270,10 +226,15 @@ static int demux_process(struct processing_module *mod,
 	/* produce output, one sink at a time */
 	for (i = 0; i < num_output_buffers; i++) {
 		if (sinks_stream[i]) {
-			demux_prepare_active_look_up(cd, sinks_stream[i],
-						     input_buffers[0].data, look_ups[i]);
-			cd->demux(dev, sinks_stream[i], input_buffers[0].data,
-				  frames, &cd->active_lookup);
+			ret = chroute_plan_update(&cd->plan[i], look_ups[i]->copy_elem,
+						  look_ups[i]->num_elems, CHROUTE_MODE_COPY,
+						  sinks_stream[i], &source, 1);
+			if (ret < 0) {
+				comp_err(dev, "demux_process(): routing failed for sink %d", i);
+				return ret;
+			}
+
+			cd->demux(dev, sinks_stream[i], source, frames, &cd->plan[i]);
 		}
 		mod->output_buffers[i].size = sink_bytes;
 	}
@@ -296,6 +257,7 @@ static int mux_process(struct processing_module *mod,
 	int frames = 0;
 	int sink_bytes;
 	int source_bytes;
+	int ret;
 	int i, j;
 
 	comp_dbg(dev, "mux_process()");
@@ -327,10 +289,16 @@ static int mux_process(struct processing_module *mod,
 
 	source_bytes = frames * audio_stream_frame_bytes(mod->input_buffers[0].data);
 	sink_bytes = frames * audio_stream_frame_bytes(mod->output_buffers[0].data);
-	mux_prepare_active_look_up(cd, output_buffers[0].data, &sources_stream[0]);
+	ret = chroute_plan_update(&cd->plan[0], cd->lookup[0].copy_elem, cd->lookup[0].num_elems,
+				  CHROUTE_MODE_COPY, output_buffers[0].data, sources_stream,
+				  MUX_MAX_STREAMS);
+	if (ret < 0) {
+		comp_err(dev, "mux_process(): routing failed");
+		return ret;
+	}
 
 	/* produce output */
-	cd->mux(dev, output_buffers[0].data, &sources_stream[0], frames, &cd->active_lookup);
+	cd->mux(dev, output_buffers[0].data, &sources_stream[0], frames, &cd->plan[0]);
 
 	/* Update consumed and produced */
 	j = 0;
@@ -16,6 +16,7 @@
 
 #if CONFIG_COMP_MUX
 
+#include <sof/audio/channel_route.h>
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/common.h>
 #include <sof/platform.h>
@@ -41,22 +42,13 @@ struct comp_dev;
 /** guard against invalid amount of streams defined */
 STATIC_ASSERT(MUX_MAX_STREAMS < PLATFORM_MAX_STREAMS,
 	      unsupported_amount_of_streams_for_mux);
+STATIC_ASSERT(MUX_MAX_STREAMS <= CHROUTE_MAX_STREAMS,
+	      unsupported_amount_of_streams_for_channel_route);
 
-struct mux_copy_elem {
-	uint32_t stream_id;
-	uint32_t in_ch;
-	uint32_t out_ch;
-
-	void *dest;
-	void *src;
-
-	uint32_t dest_inc;
-	uint32_t src_inc;
-};
-
+/* Routing table, compiled with channel_route into a plan for the connected streams */
 struct mux_look_up {
 	uint32_t num_elems;
-	struct mux_copy_elem copy_elem[PLATFORM_MAX_CHANNELS];
+	struct chroute_elem copy_elem[PLATFORM_MAX_CHANNELS];
 };
 
 struct mux_stream_data {
@@ -70,10 +62,10 @@ struct mux_stream_data {
 
 typedef void(*demux_func)(struct comp_dev *dev, struct audio_stream *sink,
 			  const struct audio_stream *source, uint32_t frames,
-			  struct mux_look_up *look_up);
+			  struct chroute_plan *plan);
 typedef void(*mux_func)(struct comp_dev *dev, struct audio_stream *sink,
 			const struct audio_stream **sources, uint32_t frames,
-			struct mux_look_up *look_up);
+			struct chroute_plan *plan);
 
 /**
  * \brief Mux/Demux component config structure.
@@ -174,7 +166,8 @@ struct comp_data {
 	};
 
 	struct mux_look_up lookup[MUX_MAX_STREAMS];
-	struct mux_look_up active_lookup;
+	/* mux uses plan[0], demux has a plan for each sink stream */
+	struct chroute_plan plan[MUX_MAX_STREAMS];
 	struct comp_data_blob_handler *model_handler;
 	struct sof_mux_config config; /* Keep last due to flexible array member in end */
 };
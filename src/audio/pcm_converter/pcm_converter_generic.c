@@ -24,6 +24,7 @@
 #include <rtos/bit.h>
 #include <sof/common.h>
 #include <sof/compiler_attributes.h>
+#include <rtos/string.h>
 #include <ipc/stream.h>
 
 #include <stddef.h>
@@ -33,6 +34,18 @@
 #define BYTES_TO_S16_SAMPLES	1
 #define BYTES_TO_S32_SAMPLES	2
 
+/* vector extensions are used only where the compiler maps them to SIMD */
+#if CONFIG_FORMAT_CONVERT_VECTOR && (defined(__SSE2__) || defined(__ARM_NEON)) && \
+	defined(__has_builtin)
+#if __has_builtin(__builtin_convertvector)
+#define PCM_CONVERTER_VECTOR 1
+#endif
+#endif
+
+#ifndef PCM_CONVERTER_VECTOR
+#define PCM_CONVERTER_VECTOR 0
+#endif
+
 #if CONFIG_PCM_CONVERTER_FORMAT_U8 && CONFIG_PCM_CONVERTER_FORMAT_S32LE
 static int pcm_convert_u8_to_s32(const struct audio_stream *source,
 				 uint32_t ioffset, struct audio_stream *sink,
@@ -93,7 +106,338 @@ static int pcm_convert_s32_to_u8(const struct audio_stream *source,
 }
 #endif /* CONFIG_PCM_CONVERTER_FORMAT_U8 && CONFIG_PCM_CONVERTER_FORMAT_S32LE */
 
+#if PCM_CONVERTER_VECTOR
+/*
+ * Vector conversion with GCC/Clang vector extensions, the compiler lowers the
+ * lane operations to SSE2 or NEON instructions. All samples are processed in
+ * 32-bit lanes, float samples are kept as raw bits in the same lanes. Hardware
+ * float conversion is used, it is exact for s16 and s24 and rounds to nearest
+ * for s32 where the bit manipulation fallback truncates.
+ */
+#define PCM_VEC_LANES	4
+
+typedef int32_t pcm_vi32_t __attribute__((vector_size(PCM_VEC_LANES * sizeof(int32_t))));
+/* float lanes are reinterpreted in place of the 32-bit integer ones */
+typedef float pcm_vf32_t __attribute__((vector_size(PCM_VEC_LANES * sizeof(int32_t))));
+
+/* sample buffers are only guaranteed to be aligned to the sample size */
+typedef int32_t pcm_vi32u_t __attribute__((vector_size(PCM_VEC_LANES * sizeof(int32_t)),
+					   aligned(sizeof(int32_t))));
+typedef int16_t pcm_vi16u_t __attribute__((vector_size(PCM_VEC_LANES * sizeof(int16_t)),
+					   aligned(sizeof(int16_t))));
+
+static inline pcm_vi32_t pcm_vec_load(const void *src, size_t sample_bytes)
+{
+	if (sample_bytes == sizeof(int16_t))
+		return __builtin_convertvector(*(const pcm_vi16u_t *)src, pcm_vi32_t);
+
+	return *(const pcm_vi32u_t *)src;
+}
+
+static inline void pcm_vec_store(void *dst, pcm_vi32_t v, size_t sample_bytes)
+{
+	if (sample_bytes == sizeof(int16_t))
+		*(pcm_vi16u_t *)dst = __builtin_convertvector(v, pcm_vi16u_t);
+	else
+		*(pcm_vi32u_t *)dst = v;
+}
+
+static inline pcm_vi32_t pcm_vec_dup(int32_t x)
+{
+	return (pcm_vi32_t){ 0 } + x;
+}
+
+/* Comparisons set all bits of the lanes where true, select a or b by mask */
+static inline pcm_vi32_t pcm_vec_select(pcm_vi32_t mask, pcm_vi32_t a, pcm_vi32_t b)
+{
+	return (a & mask) | (b & ~mask);
+}
+
+static inline pcm_vi32_t pcm_vec_sat(pcm_vi32_t v, int32_t min, int32_t max)
+{
+	v = pcm_vec_select(v > max, pcm_vec_dup(max), v);
+	return pcm_vec_select(v < min, pcm_vec_dup(min), v);
+}
+
+static inline void pcm_vec_convert_lin(const void *psrc, size_t in_bytes, void *pdst,
+				       size_t out_bytes, uint32_t samples,
+				       pcm_vi32_t (*op)(pcm_vi32_t v))
+{
+	const uint8_t *src = psrc;
+	uint8_t *dst = pdst;
+	int32_t tail_in[PCM_VEC_LANES] = { 0 };
+	int32_t tail_out[PCM_VEC_LANES];
+	uint32_t n = samples - samples % PCM_VEC_LANES;
+	uint32_t i;
+
+	for (i = 0; i < n; i += PCM_VEC_LANES)
+		pcm_vec_store(dst + i * out_bytes,
+			      op(pcm_vec_load(src + i * in_bytes, in_bytes)), out_bytes);
+
+	/* remaining samples go through one zero padded vector */
+	n = samples - n;
+	if (n) {
+		memcpy_s(tail_in, sizeof(tail_in), src + i * in_bytes, n * in_bytes);
+		pcm_vec_store(tail_out, op(pcm_vec_load(tail_in, in_bytes)), out_bytes);
+		memcpy_s(dst + i * out_bytes, n * out_bytes, tail_out, n * out_bytes);
+	}
+}
+
+static inline pcm_vi32_t pcm_vec_sign_extend_s24(pcm_vi32_t v)
+{
+	return (v << 8) >> 8;
+}
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT
+/* integer to float bits, scaled by 2^-q */
+static inline pcm_vi32_t pcm_vec_i_to_f(pcm_vi32_t v, float scale)
+{
+	return (pcm_vi32_t)(__builtin_convertvector(v, pcm_vf32_t) * scale);
+}
+
+/*
+ * Float bits scaled by 2^q to integer with rounding half away from zero like
+ * _pcm_convert_f_to_i(), saturated to [min, max]. NaN is converted to zero.
+ */
+static inline pcm_vi32_t pcm_vec_f_to_i(pcm_vi32_t v, float scale, int32_t min, int32_t max)
+{
+	pcm_vf32_t f = (pcm_vf32_t)v * scale;
+	pcm_vi32_t over = f >= -(float)min;
+	pcm_vi32_t under = f < (float)min;
+	pcm_vi32_t zero = over | under | (f != f);
+	pcm_vi32_t i;
+	pcm_vf32_t frac;
+
+	/* out of range lanes are zeroed before conversion which is undefined for them */
+	f = (pcm_vf32_t)pcm_vec_select(zero, pcm_vec_dup(0), (pcm_vi32_t)f);
+	i = __builtin_convertvector(f, pcm_vi32_t);
+	frac = f - __builtin_convertvector(i, pcm_vf32_t);
+	i -= frac >= 0.5f;
+	i += frac <= -0.5f;
+
+	i = pcm_vec_select(over, pcm_vec_dup(max), i);
+	i = pcm_vec_select(under, pcm_vec_dup(min), i);
+
+	/* rounding up can step over the maximum of s16 and s24 */
+	return pcm_vec_sat(i, min, max);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT */
+
 #if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+static inline pcm_vi32_t pcm_vec_s16_to_s24(pcm_vi32_t v)
+{
+	return v << 8;
+}
+
+static inline pcm_vi32_t pcm_vec_s24_to_s16(pcm_vi32_t v)
+{
+	v = pcm_vec_sign_extend_s24(v);
+	return pcm_vec_sat(Q_SHIFT_RND(v, 23, 15), INT16_MIN, INT16_MAX);
+}
+
+static void pcm_convert_s16_to_s24_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int16_t), pdst, sizeof(int32_t), samples,
+			    pcm_vec_s16_to_s24);
+}
+
+static void pcm_convert_s24_to_s16_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(int16_t), samples,
+			    pcm_vec_s24_to_s16);
+}
+
+static int pcm_convert_s16_to_s24(const struct audio_stream *source,
+				  uint32_t ioffset, struct audio_stream *sink,
+				  uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s16_to_s24_lin);
+}
+
+static int pcm_convert_s24_to_s16(const struct audio_stream *source,
+				  uint32_t ioffset, struct audio_stream *sink,
+				  uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s24_to_s16_lin);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE */
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static inline pcm_vi32_t pcm_vec_s16_to_s32(pcm_vi32_t v)
+{
+	return v << 16;
+}
+
+static inline pcm_vi32_t pcm_vec_s32_to_s16(pcm_vi32_t v)
+{
+	return pcm_vec_sat(Q_SHIFT_RND(v, 31, 15), INT16_MIN, INT16_MAX);
+}
+
+static void pcm_convert_s16_to_s32_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int16_t), pdst, sizeof(int32_t), samples,
+			    pcm_vec_s16_to_s32);
+}
+
+static void pcm_convert_s32_to_s16_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(int16_t), samples,
+			    pcm_vec_s32_to_s16);
+}
+
+static int pcm_convert_s16_to_s32(const struct audio_stream *source,
+				  uint32_t ioffset, struct audio_stream *sink,
+				  uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s16_to_s32_lin);
+}
+
+static int pcm_convert_s32_to_s16(const struct audio_stream *source,
+				  uint32_t ioffset, struct audio_stream *sink,
+				  uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s32_to_s16_lin);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE */
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static inline pcm_vi32_t pcm_vec_s24_to_s32(pcm_vi32_t v)
+{
+	return v << 8;
+}
+
+static inline pcm_vi32_t pcm_vec_s32_to_s24(pcm_vi32_t v)
+{
+	return pcm_vec_sat(Q_SHIFT_RND(v, 31, 23), INT24_MINVALUE, INT24_MAXVALUE);
+}
+
+static inline pcm_vi32_t pcm_vec_s32_to_s24_be(pcm_vi32_t v)
+{
+	return pcm_vec_s32_to_s24(v) << 8;
+}
+
+static void pcm_convert_s24_to_s32_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(int32_t), samples,
+			    pcm_vec_s24_to_s32);
+}
+
+static void pcm_convert_s32_to_s24_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(int32_t), samples,
+			    pcm_vec_s32_to_s24);
+}
+
+static void pcm_convert_s32_to_s24_be_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(int32_t), samples,
+			    pcm_vec_s32_to_s24_be);
+}
+
+static int pcm_convert_s24_to_s32(const struct audio_stream *source,
+				  uint32_t ioffset, struct audio_stream *sink,
+				  uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s24_to_s32_lin);
+}
+
+static int pcm_convert_s32_to_s24(const struct audio_stream *source,
+				  uint32_t ioffset, struct audio_stream *sink,
+				  uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s32_to_s24_lin);
+}
+
+static int pcm_convert_s32_to_s24_be(const struct audio_stream *source,
+				     uint32_t ioffset, struct audio_stream *sink,
+				     uint32_t ooffset, uint32_t samples)
+{
+	return pcm_convert_as_linear(source, ioffset, sink, ooffset, samples,
+				     pcm_convert_s32_to_s24_be_lin);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE */
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S16LE
+static inline pcm_vi32_t pcm_vec_s16_to_f(pcm_vi32_t v)
+{
+	return pcm_vec_i_to_f(v, 1.0f / (1 << 15));
+}
+
+static inline pcm_vi32_t pcm_vec_f_to_s16(pcm_vi32_t v)
+{
+	return pcm_vec_f_to_i(v, 1 << 15, INT16_MIN, INT16_MAX);
+}
+
+static void pcm_convert_s16_to_f_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int16_t), pdst, sizeof(float), samples,
+			    pcm_vec_s16_to_f);
+}
+
+static void pcm_convert_f_to_s16_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(float), pdst, sizeof(int16_t), samples,
+			    pcm_vec_f_to_s16);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S16LE */
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+static inline pcm_vi32_t pcm_vec_s24_to_f(pcm_vi32_t v)
+{
+	return pcm_vec_i_to_f(pcm_vec_sign_extend_s24(v), 1.0f / (1 << 23));
+}
+
+static inline pcm_vi32_t pcm_vec_f_to_s24(pcm_vi32_t v)
+{
+	return pcm_vec_f_to_i(v, 1 << 23, INT24_MINVALUE, INT24_MAXVALUE);
+}
+
+static void pcm_convert_s24_to_f_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(float), samples,
+			    pcm_vec_s24_to_f);
+}
+
+static void pcm_convert_f_to_s24_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(float), pdst, sizeof(int32_t), samples,
+			    pcm_vec_f_to_s24);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S24LE */
+
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static inline pcm_vi32_t pcm_vec_s32_to_f(pcm_vi32_t v)
+{
+	return pcm_vec_i_to_f(v, 1.0f / (1u << 31));
+}
+
+static inline pcm_vi32_t pcm_vec_f_to_s32(pcm_vi32_t v)
+{
+	return pcm_vec_f_to_i(v, 1u << 31, INT32_MIN, INT32_MAX);
+}
+
+static void pcm_convert_s32_to_f_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(int32_t), pdst, sizeof(float), samples,
+			    pcm_vec_s32_to_f);
+}
+
+static void pcm_convert_f_to_s32_lin(const void *psrc, void *pdst, uint32_t samples)
+{
+	pcm_vec_convert_lin(psrc, sizeof(float), pdst, sizeof(int32_t), samples,
+			    pcm_vec_f_to_s32);
+}
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S32LE */
+
+#endif /* PCM_CONVERTER_VECTOR */
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE && !PCM_CONVERTER_VECTOR
 
 static int pcm_convert_s16_to_s24(const struct audio_stream *source,
 				  uint32_t ioffset, struct audio_stream *sink,
@@ -155,7 +499,7 @@ static int pcm_convert_s24_to_s16(const struct audio_stream *source,
 
 #endif /* CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE */
 
-#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE && !PCM_CONVERTER_VECTOR
 
 static int pcm_convert_s16_to_s32(const struct audio_stream *source,
 				  uint32_t ioffset, struct audio_stream *sink,
@@ -217,7 +561,7 @@ static int pcm_convert_s32_to_s16(const struct audio_stream *source,
 
 #endif /* CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE */
 
-#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE && !PCM_CONVERTER_VECTOR
 
 static int pcm_convert_s24_to_s32(const struct audio_stream *source,
 				  uint32_t ioffset, struct audio_stream *sink,
@@ -308,7 +652,9 @@ static int pcm_convert_s32_to_s24_be(const struct audio_stream *source,
 
 #endif /* CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE */
 
-#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && (CONFIG_PCM_CONVERTER_FORMAT_S16LE || CONFIG_PCM_CONVERTER_FORMAT_S24LE || CONFIG_PCM_CONVERTER_FORMAT_S32LE)
+#if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && !PCM_CONVERTER_VECTOR && \
+	(CONFIG_PCM_CONVERTER_FORMAT_S16LE || CONFIG_PCM_CONVERTER_FORMAT_S24LE || \
+	 CONFIG_PCM_CONVERTER_FORMAT_S32LE)
 /*
  * IEEE 754 binary32 float format:
  *
@@ -413,9 +759,10 @@ static int32_t _pcm_convert_i_to_f(int32_t src, int32_t pow)
 	return dst;
 }
 
-#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && (CONFIG_PCM_CONVERTER_FORMAT_S16LE || CONFIG_PCM_CONVERTER_FORMAT_S24LE || CONFIG_PCM_CONVERTER_FORMAT_S32LE) */
+#endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && (S16LE || S24LE || S32LE) && !PCM_CONVERTER_VECTOR */
 
 #if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S16LE
+#if !PCM_CONVERTER_VECTOR
 static void pcm_convert_s16_to_f_lin(const void *psrc, void *pdst,
 				     uint32_t samples)
 {
@@ -441,6 +788,7 @@ static void pcm_convert_f_to_s16_lin(const void *psrc, void *pdst,
 	for (i = 0; i < samples; i++)
 		dst[i] = sat_int16(_pcm_convert_f_to_i(src[i], 15));
 }
+#endif /* !PCM_CONVERTER_VECTOR */
 
 static int pcm_convert_s16_to_f(const struct audio_stream *source,
 				uint32_t ioffset, struct audio_stream *sink,
@@ -460,6 +808,7 @@ static int pcm_convert_f_to_s16(const struct audio_stream *source,
 #endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S16LE */
 
 #if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+#if !PCM_CONVERTER_VECTOR
 static void pcm_convert_s24_to_f_lin(const void *psrc, void *pdst,
 				     uint32_t samples)
 {
@@ -485,6 +834,7 @@ static void pcm_convert_f_to_s24_lin(const void *psrc, void *pdst,
 	for (i = 0; i < samples; i++)
 		dst[i] = sat_int24(_pcm_convert_f_to_i(src[i], 23));
 }
+#endif /* !PCM_CONVERTER_VECTOR */
 
 static int pcm_convert_s24_to_f(const struct audio_stream *source,
 				uint32_t ioffset, struct audio_stream *sink,
@@ -504,6 +854,7 @@ static int pcm_convert_f_to_s24(const struct audio_stream *source,
 #endif /* CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S24LE */
 
 #if CONFIG_PCM_CONVERTER_FORMAT_FLOAT && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+#if !PCM_CONVERTER_VECTOR
 static void pcm_convert_s32_to_f_lin(const void *psrc, void *pdst,
 				     uint32_t samples)
 {
@@ -529,6 +880,7 @@ static void pcm_convert_f_to_s32_lin(const void *psrc, void *pdst,
 	for (i = 0; i < samples; i++)
 		dst[i] = _pcm_convert_f_to_i(src[i], 31);
 }
+#endif /* !PCM_CONVERTER_VECTOR */
 
 static int pcm_convert_s32_to_f(const struct audio_stream *source,
 				uint32_t ioffset, struct audio_stream *sink,
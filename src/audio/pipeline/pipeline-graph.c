@@ -190,6 +190,7 @@ int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 	comp_list = comp_buffer_list(comp, dir);
 	buffer_attach(buffer, comp_list, dir);
 	buffer_set_comp(buffer, comp, dir);
+	pipeline_copy_order_invalidate(comp->pipeline);
 
 	irq_local_enable(flags);
 
@@ -211,6 +212,7 @@ void pipeline_disconnect(struct comp_dev *comp, struct comp_buffer *buffer, int
 	comp_list = comp_buffer_list(comp, dir);
 	buffer_detach(buffer, comp_list, dir);
 	buffer_set_comp(buffer, NULL, dir);
+	pipeline_copy_order_invalidate(comp->pipeline);
 
 	irq_local_enable(flags);
 }
@@ -235,6 +237,8 @@ int pipeline_free(struct pipeline *p)
 
 	ipc_msg_free(p->msg);
 
+	pipeline_copy_order_free(p);
+
 	pipeline_posn_offset_put(p->posn_offset);
 
 	/* now free the pipeline */
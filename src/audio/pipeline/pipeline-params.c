@@ -314,6 +314,11 @@ int pipeline_prepare(struct pipeline *p, struct comp_dev *dev)
 	}
 
 	p->status = COMP_STATE_PREPARE;
+	pipeline_xrun_predict_reset(p);
+
+	/* pipeline_copy() walks the graph when the order can't be built */
+	if (pipeline_copy_order_build(p) < 0)
+		pipe_warn(p, "pipeline_prepare(): no flat copy order");
 
 	return ret;
 }
@@ -126,6 +126,163 @@ static int pipeline_comp_copy(struct comp_dev *current,
 	return err;
 }
 
+struct pipeline_order_data {
+	struct comp_dev *start;
+	struct pipeline_copy_entry *order;	/* NULL when only counting */
+	uint16_t *post;
+	uint32_t count;
+	uint32_t post_count;
+};
+
+/* Records components in the order pipeline_comp_copy() visits them */
+static int pipeline_comp_order(struct comp_dev *current,
+			       struct comp_buffer *calling_buf,
+			       struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_order_data *data = ctx->comp_data;
+	uint32_t index = data->count;
+	int err;
+
+	if (!comp_is_single_pipeline(current, data->start))
+		return 0;
+
+	if (data->order && index >= UINT16_MAX)
+		return -E2BIG;
+
+	data->count++;
+
+	err = pipeline_for_each_comp(current, ctx, dir);
+	if (err < 0)
+		return err;
+
+	if (data->order) {
+		data->order[index].comp = current;
+		data->order[index].skip = data->count;
+		data->post[data->post_count++] = index;
+	}
+
+	return 0;
+}
+
+static int pipeline_order_walk(struct pipeline *p, struct pipeline_order_data *data)
+{
+	struct pipeline_walk_context walk_ctx = {
+		.comp_func = pipeline_comp_order,
+		.comp_data = data,
+		.skip_incomplete = true,
+	};
+	int dir;
+
+	if (p->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
+		dir = PPL_DIR_UPSTREAM;
+		data->start = p->sink_comp;
+	} else {
+		dir = PPL_DIR_DOWNSTREAM;
+		data->start = p->source_comp;
+	}
+
+	data->count = 0;
+	data->post_count = 0;
+
+	return walk_ctx.comp_func(data->start, NULL, &walk_ctx, dir);
+}
+
+void pipeline_copy_order_free(struct pipeline *p)
+{
+	p->copy_order_valid = false;
+	rfree(p->copy_order);
+	p->copy_order = NULL;
+	p->copy_post = NULL;
+	p->copy_count = 0;
+}
+
+int pipeline_copy_order_build(struct pipeline *p)
+{
+	struct pipeline_order_data data = { NULL };
+	int ret;
+
+	pipeline_copy_order_free(p);
+
+	if (!p->source_comp || !p->sink_comp)
+		return -EINVAL;
+
+	/* count entries first, components reached by several paths repeat */
+	ret = pipeline_order_walk(p, &data);
+	if (ret < 0)
+		return ret;
+
+	p->copy_order = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+				data.count * (sizeof(*data.order) + sizeof(*data.post)));
+	if (!p->copy_order)
+		return -ENOMEM;
+
+	data.order = p->copy_order;
+	data.post = (uint16_t *)(data.order + data.count);
+
+	ret = pipeline_order_walk(p, &data);
+	if (ret < 0) {
+		pipeline_copy_order_free(p);
+		return ret;
+	}
+
+	p->copy_post = data.post;
+	p->copy_count = data.count;
+	p->copy_order_valid = true;
+
+	pipe_dbg(p, "pipeline_copy_order_build(): %u entries", data.count);
+
+	return 0;
+}
+
+/* Flat equivalent of the pipeline_comp_copy() graph walk. Inactive components
+ * are skipped together with all components behind them. Downstream every
+ * component is copied before the components it feeds, upstream after them.
+ */
+static int pipeline_copy_flat(struct pipeline *p, int dir)
+{
+	struct pipeline_copy_entry *order = p->copy_order;
+	uint32_t end;
+	uint32_t i;
+	int err;
+
+	if (dir == PPL_DIR_DOWNSTREAM) {
+		for (i = 0; i < p->copy_count; ) {
+			if (!comp_is_active(order[i].comp)) {
+				i = order[i].skip;
+				continue;
+			}
+
+			err = comp_copy(order[i].comp);
+			if (err < 0 || err == PPL_STATUS_PATH_STOP)
+				return err;
+			i++;
+		}
+
+		return 0;
+	}
+
+	for (i = 0; i < p->copy_count; ) {
+		if (!comp_is_active(order[i].comp)) {
+			for (end = order[i].skip; i < end; i++)
+				order[i].run = false;
+			continue;
+		}
+
+		order[i++].run = true;
+	}
+
+	for (i = 0; i < p->copy_count; i++) {
+		if (!order[p->copy_post[i]].run)
+			continue;
+
+		err = comp_copy(order[p->copy_post[i]].comp);
+		if (err < 0 || err == PPL_STATUS_PATH_STOP)
+			return err;
+	}
+
+	return 0;
+}
+
 /* Copy data across all pipeline components.
  * For capture pipelines it always starts from source component
  * and continues downstream and for playback pipelines it first
@@ -151,10 +308,14 @@ int pipeline_copy(struct pipeline *p)
 		start = p->source_comp;
 	}
 
-	data.start = start;
-	data.p = p;
+	if (p->copy_order_valid) {
+		ret = pipeline_copy_flat(p, dir);
+	} else {
+		data.start = start;
+		data.p = p;
 
-	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+		ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+	}
 	if (ret < 0)
 		pipe_err(p, "pipeline_copy(): ret = %d, start->comp.id = %u, dir = %u",
 			 ret, dev_comp_id(start), dir);
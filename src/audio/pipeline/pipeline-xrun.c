@@ -9,6 +9,8 @@
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
 #include <sof/ipc/msg.h>
+#include <sof/lib/notifier.h>
+#include <sof/math/numbers.h>
 #include <sof/list.h>
 #include <rtos/spinlock.h>
 #include <rtos/string.h>
@@ -88,6 +90,41 @@ int pipeline_xrun_recover(struct pipeline *p)
 }
 #endif
 
+#if CONFIG_XRUN_PREDICTION
+/* number of copies the margin has to stay high before prediction is armed again */
+#define XRUN_PREDICT_REARM_COPIES	64
+
+void pipeline_xrun_predict(struct pipeline *p, struct comp_dev *dev,
+			   uint32_t margin, uint32_t size)
+{
+	uint32_t threshold = size * CONFIG_XRUN_PREDICTION_MARGIN_PCT / 100;
+
+	if (!p->xrun_predicted) {
+		if (margin >= threshold)
+			return;
+
+		pipe_warn(p, "xrun predicted, comp 0x%x margin %u of %u bytes",
+			  dev_comp_id(dev), margin, size);
+		p->xrun_predicted = true;
+		p->xrun_margin_count = 0;
+		notifier_event(dev, NOTIFIER_ID_XRUN_PREDICTED,
+			       NOTIFIER_TARGET_CORE_MASK(PLATFORM_PRIMARY_CORE_ID), NULL, 0);
+		return;
+	}
+
+	/* arm again when the margin stays away from the threshold */
+	p->xrun_margin_min = p->xrun_margin_count ? MIN(p->xrun_margin_min, margin) : margin;
+	if (++p->xrun_margin_count < XRUN_PREDICT_REARM_COPIES)
+		return;
+
+	p->xrun_margin_count = 0;
+	if (p->xrun_margin_min >= 2 * threshold) {
+		pipe_info(p, "xrun prediction armed, margin %u bytes", p->xrun_margin_min);
+		p->xrun_predicted = false;
+	}
+}
+#endif
+
 int pipeline_xrun_set_limit(struct pipeline *p, uint32_t xrun_limit_usecs)
 {
 	/* TODO: these could be validated against min/max permissible values */
@@ -551,6 +551,27 @@ UT_STATIC void sys_comp_selector_init(void)
 DECLARE_MODULE(sys_comp_selector_init);
 SOF_MODULE_INIT(selector, sys_comp_selector_init);
 #else
+/* Each coefficient becomes a routing element, zero coefficients are kept so
+ * that all sink channels are written.
+ */
+static void sel_update_routes(struct comp_data *cd)
+{
+	struct chroute_elem *elem = cd->routes;
+	int i, j;
+
+	for (i = 0; i < SEL_SINK_CHANNELS_MAX; i++) {
+		for (j = 0; j < SEL_SOURCE_CHANNELS_MAX; j++) {
+			elem->stream = 0;
+			elem->in_ch = j;
+			elem->out_ch = i;
+			elem->gain = cd->coeffs_config.coeffs[i][j];
+			elem++;
+		}
+	}
+
+	chroute_plan_invalidate(&cd->plan);
+}
+
 static void build_config(struct comp_data *cd, struct module_config *cfg)
 {
 	enum sof_ipc_frame frame_fmt, valid_fmt;
@@ -580,6 +601,8 @@ static void build_config(struct comp_data *cd, struct module_config *cfg)
 	memset(&cd->coeffs_config, 0, sizeof(cd->coeffs_config));
 	for (i = 0; i < MIN(SEL_SOURCE_CHANNELS_MAX, SEL_SINK_CHANNELS_MAX); i++)
 		cd->coeffs_config.coeffs[i][i] = 1 << 10;
+
+	sel_update_routes(cd);
 }
 
 static int selector_init(struct processing_module *mod)
@@ -782,6 +805,7 @@ static int selector_set_config(struct processing_module *mod, uint32_t config_id
 			return -EINVAL;
 
 		memcpy_s(&cd->coeffs_config, sizeof(cd->coeffs_config), fragment, data_offset_size);
+		sel_update_routes(cd);
 		return 0;
 	}
 
@@ -58,18 +58,30 @@ static inline int set_func(struct processing_module *mod, enum sof_ipc_frame fmt
 	case SOF_IPC_FRAME_S16_LE:
 		comp_dbg(mod->dev, "set_func(), SOF_IPC_FRAME_S16_LE");
 		cd->tdfb_func = tdfb_fir_s16;
+#if CONFIG_COMP_TDFB_FFT
+		if (cd->fft)
+			cd->tdfb_func = tdfb_fft_s16;
+#endif
 		break;
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE
 	case SOF_IPC_FRAME_S24_4LE:
 		comp_dbg(mod->dev, "set_func(), SOF_IPC_FRAME_S24_4LE");
 		cd->tdfb_func = tdfb_fir_s24;
+#if CONFIG_COMP_TDFB_FFT
+		if (cd->fft)
+			cd->tdfb_func = tdfb_fft_s24;
+#endif
 		break;
 #endif /* CONFIG_FORMAT_S24LE */
 #if CONFIG_FORMAT_S32LE
 	case SOF_IPC_FRAME_S32_LE:
 		comp_dbg(mod->dev, "set_func(), SOF_IPC_FRAME_S32_LE");
 		cd->tdfb_func = tdfb_fir_s32;
+#if CONFIG_COMP_TDFB_FFT
+		if (cd->fft)
+			cd->tdfb_func = tdfb_fft_s32;
+#endif
 		break;
 #endif /* CONFIG_FORMAT_S32LE */
 	default:
@@ -487,6 +499,9 @@ static int tdfb_setup(struct processing_module *mod, int source_nch, int sink_nc
 {
 	struct tdfb_comp_data *cd = module_get_private_data(mod);
 	int delay_size;
+#if CONFIG_COMP_TDFB_FFT
+	int ret;
+#endif
 
 	/* If beam on, restore processing function. If off, use for same source and
 	 * sink format the efficient 1:1 copy, otherwise faster pass-through processing
@@ -509,8 +524,17 @@ static int tdfb_setup(struct processing_module *mod, int source_nch, int sink_nc
 	/* If all channels were set to bypass there's no need to
 	 * allocate delay. Just return with success.
 	 */
-	if (!delay_size)
+	if (!delay_size) {
+#if CONFIG_COMP_TDFB_FFT
+		/* Drop frequency domain data of a previous blob, the
+		 * processing function was selected above with it.
+		 */
+		tdfb_fft_free(cd);
+		if (cd->beam_on)
+			return set_func(mod, fmt);
+#endif
 		return 0;
+	}
 
 	if (delay_size > cd->fir_delay_size) {
 		/* Free existing FIR channels data if it was allocated */
@@ -531,6 +555,18 @@ static int tdfb_setup(struct processing_module *mod, int source_nch, int sink_nc
 	/* Assign delay line to all channel filters */
 	tdfb_init_delay(cd);
 
+#if CONFIG_COMP_TDFB_FFT
+	/* Switch between time and frequency domain filter bank */
+	ret = tdfb_fft_setup(cd, source_nch, sink_nch);
+	if (ret < 0) {
+		comp_err(mod->dev, "tdfb_setup(), frequency domain setup failed");
+		return ret;
+	}
+
+	if (cd->beam_on)
+		return set_func(mod, fmt);
+#endif
+
 	return 0;
 }
 
@@ -619,6 +655,9 @@ static int tdfb_free(struct processing_module *mod)
 
 	ipc_msg_free(cd->msg);
 	tdfb_free_delaylines(cd);
+#if CONFIG_COMP_TDFB_FFT
+	tdfb_fft_free(cd);
+#endif
 	comp_data_blob_handler_free(cd->model_handler);
 	tdfb_direction_free(cd);
 	rfree(cd->ctrl_data);
@@ -802,6 +841,9 @@ static int tdfb_reset(struct processing_module *mod)
 	comp_info(mod->dev, "tdfb_reset()");
 
 	tdfb_free_delaylines(cd);
+#if CONFIG_COMP_TDFB_FFT
+	tdfb_fft_free(cd);
+#endif
 
 	cd->tdfb_func = NULL;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
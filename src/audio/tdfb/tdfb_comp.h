@@ -13,6 +13,7 @@
 #include <sof/math/fir_generic.h>
 #include <sof/math/fir_hifi2ep.h>
 #include <sof/math/fir_hifi3.h>
+#include <sof/math/fft.h>
 #include <sof/math/iir_df1.h>
 #include <sof/platform.h>
 #include <sof/common.h>
@@ -45,10 +46,43 @@
 /* Process max 10% more frames than one period */
 #define TDFB_MAX_FRAMES_MULT_Q14 Q_CONVERT_FLOAT(1.10, 14)
 
+/* With frequency domain processing enabled the filter banks with at least
+ * this long filters are run with FFT.
+ */
+#define TDFB_FFT_MIN_TAPS 64
+
 /* TDFB component private data */
 
+struct tdfb_gcc_phat_data {
+	struct fft_plan *plan;
+	struct icomplex32 *fft_in;	/* FFT input, fft_size */
+	struct icomplex32 *fft_out;	/* FFT output, fft_size */
+	struct icomplex32 *x0;		/* Reference channel spectrum, num_bins */
+	struct icomplex32 *g;		/* Averaged cross spectra, (ch_count - 1) x num_bins */
+	int fft_size;
+	int num_bins;
+};
+
+struct tdfb_fft_data {
+	struct fft_plan *plan;
+	struct icomplex32 *fft_in;	/* FFT input, fft_size */
+	struct icomplex32 *fft_out;	/* FFT output, fft_size */
+	struct icomplex32 *coef;	/* Filters spectra, num_filters x num_bins */
+	struct icomplex32 *x;		/* Input channels spectra, in_nch x num_bins */
+	int32_t *in;			/* Input channels history, in_nch x fft_size */
+	int32_t *out;			/* Output channels block, out_nch x hop */
+	int fft_size;
+	int hop;			/* Frames per block, half of fft_size */
+	int num_bins;			/* Non-negative frequency bins, fft_size / 2 + 1 */
+	int num_filters;
+	int in_nch;
+	int out_nch;
+	int pos;			/* Frames index in current block */
+};
+
 struct tdfb_direction_data {
 	struct iir_state_df1 emphasis[PLATFORM_MAX_CHANNELS];
+	struct tdfb_gcc_phat_data gcc;
 	int32_t timediff[PLATFORM_MAX_CHANNELS];
 	int32_t timediff_iter[PLATFORM_MAX_CHANNELS];
 	int64_t level_ambient;
@@ -80,6 +114,7 @@ struct tdfb_comp_data {
 	struct sof_ipc_ctrl_data *ctrl_data;
 	struct ipc_msg *msg;
 	struct tdfb_direction_data direction;
+	struct tdfb_fft_data *fft;	    /**< set if frequency domain processing */
 	int32_t in[TDFB_IN_BUF_LENGTH];	    /**< input samples buffer */
 	int32_t out[TDFB_IN_BUF_LENGTH];    /**< output samples mix buffer */
 	int32_t *fir_delay;		    /**< pointer to allocated RAM */
@@ -118,11 +153,51 @@ void tdfb_fir_s32(struct tdfb_comp_data *cd,
 		  struct output_stream_buffer *bsink, int frames);
 #endif
 
+#if CONFIG_COMP_TDFB_FFT
+#if CONFIG_FORMAT_S16LE
+void tdfb_fft_s16(struct tdfb_comp_data *cd,
+		  struct input_stream_buffer *bsource,
+		  struct output_stream_buffer *bsink, int frames);
+#endif
+
+#if CONFIG_FORMAT_S24LE
+void tdfb_fft_s24(struct tdfb_comp_data *cd,
+		  struct input_stream_buffer *bsource,
+		  struct output_stream_buffer *bsink, int frames);
+#endif
+
+#if CONFIG_FORMAT_S32LE
+void tdfb_fft_s32(struct tdfb_comp_data *cd,
+		  struct input_stream_buffer *bsource,
+		  struct output_stream_buffer *bsink, int frames);
+#endif
+
+int tdfb_fft_setup(struct tdfb_comp_data *cd, int source_nch, int sink_nch);
+void tdfb_fft_free(struct tdfb_comp_data *cd);
+#endif
+
 int tdfb_direction_init(struct tdfb_comp_data *cd, int32_t fs, int channels);
 void tdfb_direction_copy_emphasis(struct tdfb_comp_data *cd, int channels, int *channel, int32_t x);
 void tdfb_direction_estimate(struct tdfb_comp_data *cd, int frames, int channels);
 void tdfb_direction_free(struct tdfb_comp_data *cd);
 
+/* The FFT library leaves the first output element for caller to set. It is set
+ * here with same scaling as in library, for IFFT as complex conjugate.
+ */
+static inline void tdfb_fft_execute_32(struct fft_plan *plan, bool ifft)
+{
+	struct icomplex32 *in = plan->inb32;
+	struct icomplex32 *out = plan->outb32;
+
+	out->real = in->real >> plan->len;
+	if (ifft)
+		out->imag = (int32_t)(-(int64_t)in->imag >> plan->len);
+	else
+		out->imag = in->imag >> plan->len;
+
+	fft_execute_32(plan, ifft);
+}
+
 static inline void tdfb_cinc_s16(int16_t **ptr, int16_t *end, size_t size)
 {
 	if (*ptr >= end)
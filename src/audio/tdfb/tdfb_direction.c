@@ -9,6 +9,7 @@
 
 #include <ipc/topology.h>
 #include <rtos/alloc.h>
+#include <sof/math/fft.h>
 #include <sof/math/iir_df1.h>
 #include <sof/math/trig.h>
 #include <sof/math/sqrt.h>
@@ -37,6 +38,15 @@
 #define AZ_ITERATIONS		8				/* loops in min err search */
 #define SOURCE_DISTANCE		Q_CONVERT_FLOAT(3.0, 12)	/* source distance in m Q4.12 */
 
+/* Coarse-to-fine angle search, the coarse scan step is 2 * pi / AZ_COARSE_STEPS
+ * and it is followed by AZ_FINE_ITERATIONS step halvings around the best angle.
+ */
+#define AZ_COARSE_STEPS		12
+#define AZ_FINE_ITERATIONS	6
+
+/* GCC-PHAT cross spectrum averaging coefficient is 2^-GCC_PHAT_AVG_SHIFT */
+#define GCC_PHAT_AVG_SHIFT	2
+
 /* Sound direction angle filtering */
 #define SLOW_AZ_C1		Q_CONVERT_FLOAT(0.02, 15)
 #define SLOW_AZ_C2		Q_CONVERT_FLOAT(0.98, 15)
@@ -176,6 +186,54 @@ static bool line_array_mode_check(struct tdfb_comp_data *cd)
 	return true;
 }
 
+#if CONFIG_COMP_TDFB_GCC_PHAT
+static void gcc_phat_free(struct tdfb_comp_data *cd)
+{
+	struct tdfb_gcc_phat_data *gcc = &cd->direction.gcc;
+
+	fft_plan_free(gcc->plan);
+	rfree(gcc->fft_in);
+	gcc->plan = NULL;
+	gcc->fft_in = NULL;
+}
+
+/* The FFT size is sufficient for the max frames per copy plus the searched
+ * lags so that the correlation computed via FFT does not wrap circularly.
+ */
+static int gcc_phat_init(struct tdfb_comp_data *cd, int ch_count)
+{
+	struct tdfb_gcc_phat_data *gcc = &cd->direction.gcc;
+	size_t size;
+	int fft_size = 2;
+
+	gcc_phat_free(cd);
+	while (fft_size < cd->max_frames + cd->direction.max_lag + 1)
+		fft_size <<= 1;
+
+	if (fft_size > FFT_SIZE_MAX)
+		return -EINVAL;
+
+	gcc->fft_size = fft_size;
+	gcc->num_bins = fft_size / 2 + 1;
+	size = (2 * fft_size + ch_count * gcc->num_bins) * sizeof(struct icomplex32);
+	gcc->fft_in = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!gcc->fft_in)
+		return -ENOMEM;
+
+	gcc->fft_out = gcc->fft_in + fft_size;
+	gcc->x0 = gcc->fft_out + fft_size;
+	gcc->g = gcc->x0 + gcc->num_bins;
+	gcc->plan = fft_plan_new(gcc->fft_in, gcc->fft_out, fft_size, 32);
+	if (!gcc->plan) {
+		rfree(gcc->fft_in);
+		gcc->fft_in = NULL;
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+#endif
+
 int tdfb_direction_init(struct tdfb_comp_data *cd, int32_t fs, int ch_count)
 {
 	struct sof_eq_iir_header *filt;
@@ -183,6 +241,7 @@ int tdfb_direction_init(struct tdfb_comp_data *cd, int32_t fs, int ch_count)
 	int32_t d_max;
 	int32_t t_max;
 	size_t size;
+	int ret = -ENOMEM;
 	int n;
 	int i;
 
@@ -242,6 +301,12 @@ int tdfb_direction_init(struct tdfb_comp_data *cd, int32_t fs, int ch_count)
 	if (!cd->direction.r)
 		goto err_free_all;
 
+#if CONFIG_COMP_TDFB_GCC_PHAT
+	ret = gcc_phat_init(cd, ch_count);
+	if (ret < 0)
+		goto err_free_all;
+#endif
+
 	/* Check for line array mode */
 	cd->direction.line_array = line_array_mode_check(cd);
 
@@ -251,17 +316,22 @@ int tdfb_direction_init(struct tdfb_comp_data *cd, int32_t fs, int ch_count)
 	return 0;
 
 err_free_all:
+	rfree(cd->direction.r);
+	cd->direction.r = NULL;
 	rfree(cd->direction.d);
 	cd->direction.d = NULL;
 
 err_free_iir:
 	rfree(cd->direction.df1_delay);
 	cd->direction.df1_delay = NULL;
-	return -ENOMEM;
+	return ret;
 }
 
 void tdfb_direction_free(struct tdfb_comp_data *cd)
 {
+#if CONFIG_COMP_TDFB_GCC_PHAT
+	gcc_phat_free(cd);
+#endif
 	rfree(cd->direction.df1_delay);
 	rfree(cd->direction.d);
 	rfree(cd->direction.r);
@@ -320,6 +390,7 @@ static int find_max_value_index(int32_t *v, int length)
 	return idx;
 }
 
+#if !CONFIG_COMP_TDFB_GCC_PHAT
 static void time_differences(struct tdfb_comp_data *cd, int frames, int ch_count)
 {
 	int64_t r;
@@ -360,6 +431,148 @@ static void time_differences(struct tdfb_comp_data *cd, int frames, int ch_count
 	cd->direction.rp += frames * ch_count;
 	tdfb_cinc_s16(&cd->direction.rp, cd->direction.d_end, cd->direction.d_size);
 }
+#endif
+
+#if CONFIG_COMP_TDFB_GCC_PHAT
+/* Spectrum of one channel from xcorr delay line, zero padded to FFT size */
+static void gcc_phat_spectrum(struct tdfb_comp_data *cd, int frames, int ch_count, int c)
+{
+	struct tdfb_gcc_phat_data *gcc = &cd->direction.gcc;
+	int16_t *x = cd->direction.rp + c;
+	int i;
+
+	tdfb_cinc_s16(&x, cd->direction.d_end, cd->direction.d_size);
+	for (i = 0; i < frames; i++) {
+		gcc->fft_in[i].real = (int32_t)*x << 16;
+		gcc->fft_in[i].imag = 0;
+		x += ch_count;
+		tdfb_cinc_s16(&x, cd->direction.d_end, cd->direction.d_size);
+	}
+
+	bzero(&gcc->fft_in[frames], (gcc->fft_size - frames) * sizeof(struct icomplex32));
+	tdfb_fft_execute_32(gcc->plan, false);
+}
+
+/* Approximate magnitude of complex number with max + 3/8 * min, the PHAT
+ * weighting does not need better precision.
+ */
+static inline int64_t gcc_phat_magnitude(int64_t re, int64_t im)
+{
+	int64_t a = re < 0 ? -re : re;
+	int64_t b = im < 0 ? -im : im;
+
+	return a > b ? a + ((3 * b) >> 3) : b + ((3 * a) >> 3);
+}
+
+/* Update the averaged PHAT weighted cross spectrum conj(X0) * Xc with current
+ * spectrum of channel c that is in FFT output.
+ */
+static void gcc_phat_cross_spectrum(struct tdfb_gcc_phat_data *gcc, struct icomplex32 *g)
+{
+	struct icomplex32 *x0 = gcc->x0;
+	struct icomplex32 *xc = gcc->fft_out;
+	int64_t mag;
+	int64_t re;
+	int64_t im;
+	int32_t re_n;
+	int32_t im_n;
+	int shift;
+	int k;
+
+	for (k = 0; k < gcc->num_bins; k++) {
+		/* Halve the products to avoid overflow in the sums */
+		re = ((int64_t)x0[k].real * xc[k].real >> 1) +
+			((int64_t)x0[k].imag * xc[k].imag >> 1);
+		im = ((int64_t)x0[k].real * xc[k].imag >> 1) -
+			((int64_t)x0[k].imag * xc[k].real >> 1);
+		mag = gcc_phat_magnitude(re, im);
+		re_n = 0;
+		im_n = 0;
+		if (mag) {
+			/* Scale to 31 bits and normalize to unit magnitude as Q1.30 */
+			shift = MAX(0, 33 - clzll(mag));
+			re_n = (int32_t)((re >> shift << 30) / (mag >> shift));
+			im_n = (int32_t)((im >> shift << 30) / (mag >> shift));
+		}
+
+		g[k].real += (re_n - g[k].real) >> GCC_PHAT_AVG_SHIFT;
+		g[k].imag += (im_n - g[k].imag) >> GCC_PHAT_AVG_SHIFT;
+	}
+}
+
+/* Sub-sample lag from parabola fit of three correlation values around peak,
+ * returned as Q1.15 fraction of sample.
+ */
+static int32_t gcc_phat_peak_fraction(int32_t r_left, int32_t r_peak, int32_t r_right)
+{
+	int64_t den = 2 * ((int64_t)r_left - 2 * (int64_t)r_peak + r_right);
+	int64_t num = (int64_t)r_left - r_right;
+
+	if (den >= 0)
+		return 0;
+
+	return (int32_t)MAX(MIN((num << 15) / den, 1 << 14), -(1 << 14));
+}
+
+/* Compute time differences of channels vs. the first channel with generalized cross
+ * correlation with phase transform. The correlation is the inverse FFT of the
+ * averaged cross spectrum, only the lags -max_lag .. +max_lag are scanned.
+ */
+static void time_differences_gcc_phat(struct tdfb_comp_data *cd, int frames, int ch_count)
+{
+	struct tdfb_gcc_phat_data *gcc = &cd->direction.gcc;
+	struct icomplex32 *g;
+	int32_t *r = cd->direction.r;
+	int32_t frac;
+	int max_lag = cd->direction.max_lag;
+	int n = gcc->fft_size;
+	int r_max_idx;
+	int c;
+	int k;
+
+	gcc_phat_spectrum(cd, frames, ch_count, 0);
+	memcpy_s(gcc->x0, gcc->num_bins * sizeof(struct icomplex32),
+		 gcc->fft_out, gcc->num_bins * sizeof(struct icomplex32));
+
+	for (c = 1; c < ch_count; c++) {
+		g = &gcc->g[(c - 1) * gcc->num_bins];
+		gcc_phat_spectrum(cd, frames, ch_count, c);
+		gcc_phat_cross_spectrum(gcc, g);
+
+		/* Complex conjugate symmetric spectrum for real valued correlation,
+		 * scaled down by FFT size since the inverse FFT is not normalized.
+		 */
+		for (k = 0; k < gcc->num_bins; k++) {
+			gcc->fft_in[k].real = g[k].real >> gcc->plan->len;
+			gcc->fft_in[k].imag = g[k].imag >> gcc->plan->len;
+		}
+
+		for (k = 1; k < n / 2; k++) {
+			gcc->fft_in[n - k].real = gcc->fft_in[k].real;
+			gcc->fft_in[n - k].imag = -gcc->fft_in[k].imag;
+		}
+
+		tdfb_fft_execute_32(gcc->plan, true);
+
+		/* Negative lags are at the end of the IFFT output */
+		for (k = -max_lag; k <= max_lag; k++)
+			r[k + max_lag] = gcc->fft_out[k < 0 ? n + k : k].real;
+
+		r_max_idx = find_max_value_index(r, 2 * max_lag + 1);
+		frac = 0;
+		if (r_max_idx > 0 && r_max_idx < 2 * max_lag)
+			frac = gcc_phat_peak_fraction(r[r_max_idx - 1], r[r_max_idx],
+						      r[r_max_idx + 1]);
+
+		cd->direction.timediff[c - 1] = (int32_t)(r_max_idx - max_lag) *
+			cd->direction.unit_delay +
+			Q_MULTSR_32X32((int64_t)frac, cd->direction.unit_delay, 15, 31, 31);
+	}
+
+	cd->direction.rp += frames * ch_count;
+	tdfb_cinc_s16(&cd->direction.rp, cd->direction.d_end, cd->direction.d_size);
+}
+#endif
 
 static int16_t distance_from_source(struct tdfb_comp_data *cd, int mic_n,
 				    int16_t x, int16_t y, int16_t z)
@@ -435,36 +648,12 @@ static int unwrap_radians(int radians)
 	return a;
 }
 
-static void iterate_source_angle(struct tdfb_comp_data *cd)
+/* Fold, store and low-pass filter the found source angle */
+static void update_source_angle(struct tdfb_comp_data *cd, int az)
 {
-	int64_t err_prev;
-	int64_t err;
 	int32_t ds1;
 	int32_t ds2;
 	int az_slow;
-	int i;
-	int az_step = AZ_STEP * cd->direction.step_sign;
-	int az = cd->direction.az_slow;
-
-	/* Start next iteration opposite direction */
-	cd->direction.step_sign *= -1;
-
-	/* Get theoretical time differences for previous angle */
-	theoretical_time_differences(cd, az);
-	err_prev = mean_square_time_difference_err(cd);
-
-	for (i = 0; i < AZ_ITERATIONS; i++) {
-		az += az_step;
-		theoretical_time_differences(cd, az);
-		err = mean_square_time_difference_err(cd);
-		if (err > err_prev) {
-			az_step = -(az_step >> 1);
-			if (az_step == 0)
-				break;
-		}
-
-		err_prev = err;
-	}
 
 	az = unwrap_radians(az);
 	if (cd->direction.line_array) {
@@ -500,6 +689,93 @@ static void iterate_source_angle(struct tdfb_comp_data *cd)
 	cd->direction.az_slow = unwrap_radians(az_slow);
 }
 
+#if !CONFIG_COMP_TDFB_GCC_PHAT
+static void iterate_source_angle(struct tdfb_comp_data *cd)
+{
+	int64_t err_prev;
+	int64_t err;
+	int i;
+	int az_step = AZ_STEP * cd->direction.step_sign;
+	int az = cd->direction.az_slow;
+
+	/* Start next iteration opposite direction */
+	cd->direction.step_sign *= -1;
+
+	/* Get theoretical time differences for previous angle */
+	theoretical_time_differences(cd, az);
+	err_prev = mean_square_time_difference_err(cd);
+
+	for (i = 0; i < AZ_ITERATIONS; i++) {
+		az += az_step;
+		theoretical_time_differences(cd, az);
+		err = mean_square_time_difference_err(cd);
+		if (err > err_prev) {
+			az_step = -(az_step >> 1);
+			if (az_step == 0)
+				break;
+		}
+
+		err_prev = err;
+	}
+
+	update_source_angle(cd, az);
+}
+#endif
+
+#if CONFIG_COMP_TDFB_GCC_PHAT
+/* Scan the full circle or half circle for line arrays with coarse step, then
+ * refine around the best angle with halving step. Unlike the iteration from
+ * previous angle this can't get stuck in a local minimum.
+ */
+static void search_source_angle(struct tdfb_comp_data *cd)
+{
+	int64_t err_min;
+	int64_t err;
+	int az_step = PIMUL2_Q12 / AZ_COARSE_STEPS;
+	int az_start = -PI_Q12 + az_step;
+	int az_end = PI_Q12;
+	int az_best;
+	int az;
+	int i;
+
+	if (cd->direction.line_array) {
+		az_start = -PIDIV2_Q12;
+		az_end = PIDIV2_Q12;
+	}
+
+	az_best = az_start;
+	err_min = INT64_MAX;
+	for (az = az_start; az <= az_end; az += az_step) {
+		theoretical_time_differences(cd, az);
+		err = mean_square_time_difference_err(cd);
+		if (err < err_min) {
+			err_min = err;
+			az_best = az;
+		}
+	}
+
+	for (i = 0; i < AZ_FINE_ITERATIONS; i++) {
+		az_step >>= 1;
+		az = az_best;
+		theoretical_time_differences(cd, az - az_step);
+		err = mean_square_time_difference_err(cd);
+		if (err < err_min) {
+			err_min = err;
+			az_best = az - az_step;
+		}
+
+		theoretical_time_differences(cd, az + az_step);
+		err = mean_square_time_difference_err(cd);
+		if (err < err_min) {
+			err_min = err;
+			az_best = az + az_step;
+		}
+	}
+
+	update_source_angle(cd, az_best);
+}
+#endif
+
 static void updates_when_no_trigger(struct tdfb_comp_data *cd, int frames, int ch_count)
 {
 	cd->direction.rp += frames * ch_count;
@@ -543,11 +819,17 @@ void tdfb_direction_estimate(struct tdfb_comp_data *cd, int frames, int ch_count
 		return;
 	}
 
+#if CONFIG_COMP_TDFB_GCC_PHAT
+	/* Compute time differences with GCC-PHAT and search the angle */
+	time_differences_gcc_phat(cd, frames, ch_count);
+	search_source_angle(cd);
+#else
 	/* Compute time differences of ch_count vs. reference channel 1 */
 	time_differences(cd, frames, ch_count);
 
 	/* Determine direction angle */
 	iterate_source_angle(cd);
+#endif
 
 	/* Convert radians to enum*/
 	new_az_value = convert_angle_to_enum(cd);
@@ -0,0 +1,397 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/format.h>
+#include <sof/math/fft.h>
+#include <sof/common.h>
+#include <rtos/alloc.h>
+#include <rtos/string.h>
+#include <user/fir.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tdfb.h"
+#include "tdfb_comp.h"
+
+#if CONFIG_COMP_TDFB_FFT
+
+/*
+ * Frequency domain version of the filter and sum beamformer. The filter bank
+ * is run as overlap-save block convolution. For every block of hop frames each
+ * used input channel is transformed once, the filters are applied as complex
+ * multiply per bin and summed to output channels, then each output channel is
+ * transformed back to time domain. The FFT size is at least two times the
+ * longest filter so the last hop samples of inverse FFT are free of circular
+ * convolution wrap.
+ */
+
+static void tdfb_fft_block(struct tdfb_comp_data *cd)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+	struct icomplex32 *h;
+	struct icomplex32 *x;
+	int32_t *in;
+	int32_t *out;
+	int64_t re;
+	int64_t im;
+	int16_t filter_idx[SOF_TDFB_FIR_MAX_COUNT];
+	uint32_t in_mask = 0;
+	int num_mix;
+	int ch;
+	int i;
+	int j;
+	int k;
+	const int n = fft->fft_size;
+	const int hop = fft->hop;
+	const int bins = fft->num_bins;
+	/* Product of two library scaled spectra is 1/n too small */
+	const int shift = 31 - fft->plan->len;
+
+	for (i = 0; i < fft->num_filters; i++)
+		in_mask |= BIT(cd->input_channel_select[i]);
+
+	/* Spectra of the input channels used by filters */
+	for (ch = 0; ch < fft->in_nch; ch++) {
+		in = &fft->in[ch * n];
+		if (in_mask & BIT(ch)) {
+			for (j = 0; j < n; j++) {
+				fft->fft_in[j].real = in[j];
+				fft->fft_in[j].imag = 0;
+			}
+
+			tdfb_fft_execute_32(fft->plan, false);
+			memcpy_s(&fft->x[ch * bins], bins * sizeof(struct icomplex32),
+				 fft->fft_out, bins * sizeof(struct icomplex32));
+		}
+
+		/* Drop the oldest hop samples from history */
+		memmove(in, in + hop, (n - hop) * sizeof(int32_t));
+	}
+
+	for (ch = 0; ch < fft->out_nch; ch++) {
+		/* Find filters those are mixed to this output channel */
+		num_mix = 0;
+		for (i = 0; i < fft->num_filters; i++) {
+			if (cd->output_channel_mix[i] & BIT(ch))
+				filter_idx[num_mix++] = i;
+		}
+
+		/* Filter and sum per frequency bin */
+		for (k = 0; k < bins; k++) {
+			re = 0;
+			im = 0;
+			for (i = 0; i < num_mix; i++) {
+				h = &fft->coef[filter_idx[i] * bins + k];
+				x = &fft->x[cd->input_channel_select[filter_idx[i]] * bins + k];
+				re += (int64_t)h->real * x->real - (int64_t)h->imag * x->imag;
+				im += (int64_t)h->real * x->imag + (int64_t)h->imag * x->real;
+			}
+
+			fft->fft_in[k].real = sat_int32(re >> shift);
+			fft->fft_in[k].imag = sat_int32(im >> shift);
+		}
+
+		/* Complex conjugate symmetric upper half for real output */
+		for (k = 1; k < hop; k++) {
+			fft->fft_in[n - k].real = fft->fft_in[k].real;
+			fft->fft_in[n - k].imag = sat_int32(-(int64_t)fft->fft_in[k].imag);
+		}
+
+		tdfb_fft_execute_32(fft->plan, true);
+
+		/* Overlap-save, keep the last hop samples */
+		out = &fft->out[ch * hop];
+		for (j = 0; j < hop; j++)
+			out[j] = fft->fft_out[n - hop + j].real;
+	}
+}
+
+/* Advance to next frame in block and run the block processing when the
+ * block is complete.
+ */
+static inline void tdfb_fft_next_frame(struct tdfb_comp_data *cd)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+
+	if (++fft->pos == fft->hop) {
+		tdfb_fft_block(cd);
+		fft->pos = 0;
+	}
+}
+
+#if CONFIG_FORMAT_S16LE
+void tdfb_fft_s16(struct tdfb_comp_data *cd, struct input_stream_buffer *bsource,
+		  struct output_stream_buffer *bsink, int frames)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	int16_t *x = audio_stream_get_rptr(source);
+	int16_t *y = audio_stream_get_wptr(sink);
+	int32_t *in;
+	int32_t *out;
+	int fmax;
+	int i;
+	int j;
+	int f;
+	const int in_nch = audio_stream_get_channels(source);
+	const int out_nch = audio_stream_get_channels(sink);
+	int remaining_frames = frames;
+	int emp_ch = 0;
+
+	while (remaining_frames) {
+		fmax = audio_stream_frames_without_wrap(source, x);
+		f = MIN(remaining_frames, fmax);
+		fmax = audio_stream_frames_without_wrap(sink, y);
+		f = MIN(f, fmax);
+		for (j = 0; j < f; j++) {
+			in = &fft->in[fft->fft_size - fft->hop + fft->pos];
+			for (i = 0; i < in_nch; i++) {
+				*in = *x << 16;
+				if (cd->direction_updates)
+					tdfb_direction_copy_emphasis(cd, in_nch, &emp_ch, *x << 16);
+
+				in += fft->fft_size;
+				x++;
+			}
+
+			out = &fft->out[fft->pos];
+			for (i = 0; i < out_nch; i++) {
+				*y = sat_int16(Q_SHIFT_RND(*out, 31, 15));
+				out += fft->hop;
+				y++;
+			}
+
+			tdfb_fft_next_frame(cd);
+		}
+		remaining_frames -= f;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif
+
+#if CONFIG_FORMAT_S24LE
+void tdfb_fft_s24(struct tdfb_comp_data *cd, struct input_stream_buffer *bsource,
+		  struct output_stream_buffer *bsink, int frames)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y = audio_stream_get_wptr(sink);
+	int32_t *in;
+	int32_t *out;
+	int fmax;
+	int i;
+	int j;
+	int f;
+	const int in_nch = audio_stream_get_channels(source);
+	const int out_nch = audio_stream_get_channels(sink);
+	int remaining_frames = frames;
+	int emp_ch = 0;
+
+	while (remaining_frames) {
+		fmax = audio_stream_frames_without_wrap(source, x);
+		f = MIN(remaining_frames, fmax);
+		fmax = audio_stream_frames_without_wrap(sink, y);
+		f = MIN(f, fmax);
+		for (j = 0; j < f; j++) {
+			in = &fft->in[fft->fft_size - fft->hop + fft->pos];
+			for (i = 0; i < in_nch; i++) {
+				*in = *x << 8;
+				if (cd->direction_updates)
+					tdfb_direction_copy_emphasis(cd, in_nch, &emp_ch, *x << 8);
+
+				in += fft->fft_size;
+				x++;
+			}
+
+			out = &fft->out[fft->pos];
+			for (i = 0; i < out_nch; i++) {
+				*y = sat_int24(Q_SHIFT_RND(*out, 31, 23));
+				out += fft->hop;
+				y++;
+			}
+
+			tdfb_fft_next_frame(cd);
+		}
+		remaining_frames -= f;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif
+
+#if CONFIG_FORMAT_S32LE
+void tdfb_fft_s32(struct tdfb_comp_data *cd, struct input_stream_buffer *bsource,
+		  struct output_stream_buffer *bsink, int frames)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y = audio_stream_get_wptr(sink);
+	int32_t *in;
+	int32_t *out;
+	int fmax;
+	int i;
+	int j;
+	int f;
+	const int in_nch = audio_stream_get_channels(source);
+	const int out_nch = audio_stream_get_channels(sink);
+	int remaining_frames = frames;
+	int emp_ch = 0;
+
+	while (remaining_frames) {
+		fmax = audio_stream_frames_without_wrap(source, x);
+		f = MIN(remaining_frames, fmax);
+		fmax = audio_stream_frames_without_wrap(sink, y);
+		f = MIN(f, fmax);
+		for (j = 0; j < f; j++) {
+			in = &fft->in[fft->fft_size - fft->hop + fft->pos];
+			for (i = 0; i < in_nch; i++) {
+				*in = *x;
+				if (cd->direction_updates)
+					tdfb_direction_copy_emphasis(cd, in_nch, &emp_ch, *x);
+
+				in += fft->fft_size;
+				x++;
+			}
+
+			out = &fft->out[fft->pos];
+			for (i = 0; i < out_nch; i++) {
+				*y = *out;
+				out += fft->hop;
+				y++;
+			}
+
+			tdfb_fft_next_frame(cd);
+		}
+		remaining_frames -= f;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif
+
+void tdfb_fft_free(struct tdfb_comp_data *cd)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+
+	if (!fft)
+		return;
+
+	fft_plan_free(fft->plan);
+	rfree(fft->fft_in);
+	rfree(fft);
+	cd->fft = NULL;
+}
+
+static int tdfb_fft_alloc(struct tdfb_comp_data *cd, int fft_size, int num_filters,
+			  int source_nch, int sink_nch)
+{
+	struct tdfb_fft_data *fft;
+	int num_bins = fft_size / 2 + 1;
+	int hop = fft_size / 2;
+	size_t size;
+
+	fft = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*fft));
+	if (!fft)
+		return -ENOMEM;
+
+	/* All buffers are allocated as single chunk, complex data first to keep
+	 * the 64 bit alignment.
+	 */
+	size = (2 * fft_size + (num_filters + source_nch) * num_bins) * sizeof(struct icomplex32) +
+		(source_nch * fft_size + sink_nch * hop) * sizeof(int32_t);
+	fft->fft_in = rballoc(0, SOF_MEM_CAPS_RAM, size);
+	if (!fft->fft_in) {
+		rfree(fft);
+		return -ENOMEM;
+	}
+
+	bzero(fft->fft_in, size);
+	fft->fft_out = fft->fft_in + fft_size;
+	fft->coef = fft->fft_out + fft_size;
+	fft->x = fft->coef + num_filters * num_bins;
+	fft->in = (int32_t *)(fft->x + source_nch * num_bins);
+	fft->out = fft->in + source_nch * fft_size;
+
+	fft->plan = fft_plan_new(fft->fft_in, fft->fft_out, fft_size, 32);
+	if (!fft->plan) {
+		rfree(fft->fft_in);
+		rfree(fft);
+		return -ENOMEM;
+	}
+
+	fft->fft_size = fft_size;
+	fft->hop = hop;
+	fft->num_bins = num_bins;
+	fft->num_filters = num_filters;
+	fft->in_nch = source_nch;
+	fft->out_nch = sink_nch;
+	cd->fft = fft;
+	return 0;
+}
+
+/*
+ * Called after filter bank is initialized. Selects the frequency domain
+ * processing if filters are long enough and computes the spectra of the
+ * filters. The input history is preserved if only the filters change, e.g.
+ * for a new beam angle.
+ */
+int tdfb_fft_setup(struct tdfb_comp_data *cd, int source_nch, int sink_nch)
+{
+	struct tdfb_fft_data *fft = cd->fft;
+	struct fir_state_32x16 *fir;
+	int num_filters = cd->config->num_filters;
+	int max_taps = 0;
+	int fft_size = 2;
+	int ret;
+	int i;
+	int j;
+
+	for (i = 0; i < num_filters; i++)
+		max_taps = MAX(max_taps, cd->fir[i].taps);
+
+	while (fft_size < 2 * max_taps)
+		fft_size <<= 1;
+
+	/* Use time domain processing for short filters */
+	if (max_taps < TDFB_FFT_MIN_TAPS || fft_size > FFT_SIZE_MAX) {
+		tdfb_fft_free(cd);
+		return 0;
+	}
+
+	if (!fft || fft->fft_size != fft_size || fft->num_filters != num_filters ||
+	    fft->in_nch != source_nch || fft->out_nch != sink_nch) {
+		tdfb_fft_free(cd);
+		ret = tdfb_fft_alloc(cd, fft_size, num_filters, source_nch, sink_nch);
+		if (ret < 0)
+			return ret;
+
+		fft = cd->fft;
+	}
+
+	/* Filter spectra, the Q1.15 coefficients with FIR output shift are
+	 * converted to Q1.31.
+	 */
+	for (i = 0; i < num_filters; i++) {
+		fir = &cd->fir[i];
+		bzero(fft->fft_in, fft_size * sizeof(struct icomplex32));
+		for (j = 0; j < fir->taps; j++)
+			fft->fft_in[j].real = ((int32_t)fir->coef[j] << 16) >> fir->out_shift;
+
+		tdfb_fft_execute_32(fft->plan, false);
+		memcpy_s(&fft->coef[i * fft->num_bins], fft->num_bins * sizeof(struct icomplex32),
+			 fft->fft_out, fft->num_bins * sizeof(struct icomplex32));
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_COMP_TDFB_FFT */
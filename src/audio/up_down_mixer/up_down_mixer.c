@@ -6,6 +6,7 @@
 // Author: Adrian Bonislawski <adrian.bonislawski@intel.com>
 
 #include <sof/audio/buffer.h>
+#include <sof/audio/channel_route.h>
 #include <sof/audio/format.h>
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/audio/pipeline.h>
@@ -110,6 +111,87 @@ static int set_downmix_coefficients(struct processing_module *mod,
 	return 0;
 }
 
+/* Input channel value of a routing element that silences the output channel */
+#define ROUTE_SILENCE	-1
+
+/*
+ * 32 bit copies and upmixes only move whole samples between channels,
+ * these are run by the shared routing engine.
+ */
+static void route32bit(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+		       const uint32_t in_size, uint8_t * const out_data)
+{
+	const void *src[CHROUTE_MAX_STREAMS] = { in_data };
+
+	chroute_process_frames(&cd->plan, out_data, src,
+			       in_size / (cd->in_channel_no * sizeof(int32_t)));
+}
+
+static void add_route(struct chroute_elem *elems, int *num_elems, int in_ch, uint8_t out_ch)
+{
+	struct chroute_elem *elem = &elems[*num_elems];
+
+	/* channel is not present in the output channel map */
+	if (out_ch == CHANNEL_INVALID)
+		return;
+
+	elem->stream = 0;
+	elem->in_ch = in_ch == ROUTE_SILENCE ? 0 : in_ch;
+	elem->out_ch = out_ch;
+	elem->gain = in_ch == ROUTE_SILENCE ? 0 : CHROUTE_UNITY_GAIN;
+	(*num_elems)++;
+}
+
+static int init_route(struct up_down_mixer_data *cd, const struct ipc4_audio_format *format,
+		      enum ipc4_channel_config out_channel_config)
+{
+	uint8_t source_channels[CHROUTE_MAX_STREAMS] = { format->channels_count };
+	struct chroute_elem elems[CHROUTE_MAX_CHANNELS];
+	channel_map map = cd->out_channel_map;
+	int right = format->channels_count > 1 ? 1 : 0;
+	uint8_t left_surround_slot;
+	uint8_t right_surround_slot;
+	uint8_t sink_channels;
+	int n = 0;
+
+	if (out_channel_config == IPC4_CHANNEL_CONFIG_STEREO) {
+		/* mono is copied to both channels */
+		add_route(elems, &n, 0, 0);
+		add_route(elems, &n, right, 1);
+		sink_channels = 2;
+	} else {
+		left_surround_slot = get_channel_location(map, CHANNEL_LEFT_SURROUND);
+		right_surround_slot = get_channel_location(map, CHANNEL_RIGHT_SURROUND);
+
+		/* Must support also 5.1 Surround */
+		if (out_channel_config == IPC4_CHANNEL_CONFIG_5_POINT_1 &&
+		    left_surround_slot == CHANNEL_INVALID &&
+		    right_surround_slot == CHANNEL_INVALID) {
+			left_surround_slot = get_channel_location(map, CHANNEL_LEFT_SIDE);
+			right_surround_slot = get_channel_location(map, CHANNEL_RIGHT_SIDE);
+		}
+
+		add_route(elems, &n, 0, get_channel_location(map, CHANNEL_LEFT));
+		add_route(elems, &n, right, get_channel_location(map, CHANNEL_RIGHT));
+		add_route(elems, &n, ROUTE_SILENCE, get_channel_location(map, CHANNEL_CENTER));
+		add_route(elems, &n, 0, left_surround_slot);
+		add_route(elems, &n, right, right_surround_slot);
+		add_route(elems, &n, ROUTE_SILENCE, get_channel_location(map, CHANNEL_LFE));
+		sink_channels = 6;
+
+		if (out_channel_config == IPC4_CHANNEL_CONFIG_7_POINT_1) {
+			add_route(elems, &n, ROUTE_SILENCE,
+				  get_channel_location(map, CHANNEL_LEFT_SIDE));
+			add_route(elems, &n, ROUTE_SILENCE,
+				  get_channel_location(map, CHANNEL_RIGHT_SIDE));
+			sink_channels = 8;
+		}
+	}
+
+	return chroute_plan_compile(&cd->plan, elems, n, CHROUTE_MODE_MIX, SOF_IPC_FRAME_S32_LE,
+				    sink_channels, source_channels);
+}
+
 static up_down_mixer_routine select_mix_out_stereo(struct comp_dev *dev,
 						   const struct ipc4_audio_format *format)
 {
@@ -142,10 +224,9 @@ static up_down_mixer_routine select_mix_out_stereo(struct comp_dev *dev,
 	} else {
 		switch (format->ch_cfg) {
 		case IPC4_CHANNEL_CONFIG_MONO:
-			return shiftcopy32bit_mono;
 		case IPC4_CHANNEL_CONFIG_DUAL_MONO:
 		case IPC4_CHANNEL_CONFIG_STEREO:
-			return shiftcopy32bit_stereo;
+			return route32bit;
 		case IPC4_CHANNEL_CONFIG_2_POINT_1:
 			return downmix32bit_2_1;
 		case IPC4_CHANNEL_CONFIG_3_POINT_0:
@@ -243,9 +324,8 @@ static up_down_mixer_routine select_mix_out_5_1(struct comp_dev *dev,
 	} else {
 		switch (format->ch_cfg) {
 		case IPC4_CHANNEL_CONFIG_MONO:
-			return upmix32bit_1_to_5_1;
 		case IPC4_CHANNEL_CONFIG_STEREO:
-			return upmix32bit_2_0_to_5_1;
+			return route32bit;
 		case IPC4_CHANNEL_CONFIG_QUATRO:
 			return upmix32bit_quatro_to_5_1;
 		case IPC4_CHANNEL_CONFIG_4_POINT_0:
@@ -267,6 +347,7 @@ static int init_mix(struct processing_module *mod,
 {
 	struct up_down_mixer_data *cd = module_get_private_data(mod);
 	struct comp_dev *dev = mod->dev;
+	int ret;
 
 	if (!format)
 		return -EINVAL;
@@ -306,7 +387,7 @@ static int init_mix(struct processing_module *mod,
 	} else if (out_channel_config == IPC4_CHANNEL_CONFIG_7_POINT_1 &&
 		   format->ch_cfg == IPC4_CHANNEL_CONFIG_STEREO) {
 		/* Select up mixing routine. */
-		cd->mix_routine = upmix32bit_2_0_to_7_1;
+		cd->mix_routine = route32bit;
 
 		if (format->depth == IPC4_DEPTH_16BIT)
 			return -EINVAL;
@@ -322,6 +403,12 @@ static int init_mix(struct processing_module *mod,
 	cd->in_channel_map = format->ch_map;
 	cd->in_channel_config = format->ch_cfg;
 
+	if (cd->mix_routine == route32bit) {
+		ret = init_route(cd, format, out_channel_config);
+		if (ret < 0)
+			return ret;
+	}
+
 	return set_downmix_coefficients(mod, format, out_channel_config, downmix_coefficients);
 }
 
@@ -8,6 +8,7 @@
 #ifndef __SOF_AUDIO_UP_DOWN_MIXER_H__
 #define __SOF_AUDIO_UP_DOWN_MIXER_H__
 
+#include <sof/audio/channel_route.h>
 #include <sof/audio/component_ext.h>
 #include <sof/audio/ipc-config.h>
 #include <sof/common.h>
@@ -125,6 +126,9 @@ struct up_down_mixer_data {
 	/** Function pointer to up/down-mix routine. */
 	up_down_mixer_routine mix_routine;
 
+	/** Routing plan of the 32 bit copies and upmixes, used by route32bit(). */
+	struct chroute_plan plan;
+
 	/** Downmix coefficients. */
 	downmix_coefficients downmix_coefficients;
 
@@ -144,17 +148,6 @@ struct up_down_mixer_data {
 	int32_t *buf_out;
 };
 
-/**
- * \brief 32 bit upmixer (mono -> 5_1).
- *
- * \param[in]   cd                      Component private data.
- * \param[in]   in_data                 Input buffer.
- * \param[in]   in_size                 Input buffer size.
- * \param[out]  out_data                Output buffer.
- */
-void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data);
-
 /**
  * \brief 16 bit upmixer (mono -> 5_1).
  *
@@ -166,17 +159,6 @@ void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in
 void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			 const uint32_t in_size, uint8_t * const out_data);
 
-/**
- * \brief 32 bit upmixer (2_0 -> 5_1).
- *
- * \param[in]   cd                      Component private data.
- * \param[in]   in_data                 Input buffer.
- * \param[in]   in_size                 Input buffer size.
- * \param[out]  out_data                Output buffer.
- */
-void upmix32bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data);
-
 /**
  * \brief 16 bit upmixer (2_0 -> 5_1).
  *
@@ -188,41 +170,6 @@ void upmix32bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const
 void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			   const uint32_t in_size, uint8_t * const out_data);
 
-/**
- * \brief 32 bit upmixer (2_0 -> 7_1).
- *
- * \param[in]   cd                      Component private data.
- * \param[in]   in_data                 Input buffer.
- * \param[in]   in_size                 Input buffer size.
- * \param[out]  out_data                Output buffer.
- */
-void upmix32bit_2_0_to_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data);
-
-/**
- * \brief 32 bit shift copier for mono streams.
- *		  Copy the 32 MSB input mono stream (left, right) to 32 MSB stereo one.
- *
- * \param[in]   cd                      Component private data.
- * \param[in]   in_data                 Input buffer.
- * \param[in]   in_size                 Input buffer size.
- * \param[out]  out_data                Output buffer.
- */
-void shiftcopy32bit_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data);
-
-/**
- * \brief 32 bit shift copier for stereo.
- *		  Copy the 32 MSB input streo stream (left, right) to 32 MSB one.
- *
- * \param[in]   cd                      Component private data.
- * \param[in]   in_data                 Input buffer.
- * \param[in]   in_size                 Input buffer size.
- * \param[out]  out_data                Output buffer.
- */
-void shiftcopy32bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data);
-
 /**
  * \brief 24 bit downmixer specialized for the 2.1.
  * \note implementation is based on Downmix32bit
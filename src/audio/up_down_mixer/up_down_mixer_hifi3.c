@@ -13,39 +13,6 @@
 #include <stddef.h>
 #include <stdint.h>
 
-void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data)
-{
-	uint32_t i;
-
-	channel_map out_channel_map = cd->out_channel_map;
-
-	/* Only load the channel if it's present. */
-	ae_int32 *output_left = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LEFT) << 2));
-	ae_int32 *output_center = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_CENTER) << 2));
-	ae_int32 *output_right = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_RIGHT) << 2));
-	ae_int32 *output_left_surround = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LEFT_SURROUND) << 2));
-	ae_int32 *output_right_surround = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_RIGHT_SURROUND) << 2));
-	ae_int32 *output_lfe = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LFE) << 2));
-
-	ae_int32 *in_ptr = (ae_int32 *)in_data;
-
-	for (i = 0; i < (in_size >> 2); ++i) {
-		output_left[i * 6] = in_ptr[i];
-		output_right[i * 6] = in_ptr[i];
-		output_center[i * 6] = 0;
-		output_left_surround[i * 6] = in_ptr[i];
-		output_right_surround[i * 6] = in_ptr[i];
-		output_lfe[i * 6] = 0;
-	}
-}
-
 void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			 const uint32_t in_size, uint8_t * const out_data)
 {
@@ -79,46 +46,6 @@ void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in
 	}
 }
 
-void upmix32bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data)
-{
-	uint32_t i;
-
-	channel_map out_channel_map = cd->out_channel_map;
-
-	const uint8_t left_slot = get_channel_location(out_channel_map, CHANNEL_LEFT);
-	const uint8_t center_slot = get_channel_location(out_channel_map, CHANNEL_CENTER);
-	const uint8_t right_slot = get_channel_location(out_channel_map, CHANNEL_RIGHT);
-	uint8_t left_surround_slot = get_channel_location(out_channel_map, CHANNEL_LEFT_SURROUND);
-	uint8_t right_surround_slot = get_channel_location(out_channel_map, CHANNEL_RIGHT_SURROUND);
-	const uint8_t lfe_slot = get_channel_location(out_channel_map, CHANNEL_LFE);
-
-	/* Must support also 5.1 Surround */
-	if (left_surround_slot == CHANNEL_INVALID && right_surround_slot == CHANNEL_INVALID) {
-		left_surround_slot = get_channel_location(out_channel_map, CHANNEL_LEFT_SIDE);
-		right_surround_slot = get_channel_location(out_channel_map, CHANNEL_RIGHT_SIDE);
-	}
-
-	ae_int32 *output_left = (ae_int32 *)(out_data + (left_slot << 2));
-	ae_int32 *output_center = (ae_int32 *)(out_data + (center_slot << 2));
-	ae_int32 *output_right = (ae_int32 *)(out_data + (right_slot << 2));
-	ae_int32 *output_left_surround = (ae_int32 *)(out_data + (left_surround_slot << 2));
-	ae_int32 *output_right_surround = (ae_int32 *)(out_data + (right_surround_slot << 2));
-	ae_int32 *output_lfe = (ae_int32 *)(out_data + (lfe_slot << 2));
-
-	ae_int32 *in_left_ptr = (ae_int32 *)in_data;
-	ae_int32 *in_right_ptr = (ae_int32 *)(in_data + 4);
-
-	for (i = 0; i < (in_size >> 3); ++i) {
-		output_left[i * 6] = in_left_ptr[i * 2];
-		output_right[i * 6] = in_right_ptr[i * 2];
-		output_center[i * 6] = 0;
-		output_left_surround[i * 6] = in_left_ptr[i * 2];
-		output_right_surround[i * 6] = in_right_ptr[i * 2];
-		output_lfe[i * 6] = 0;
-	}
-}
-
 void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			   const uint32_t in_size, uint8_t * const out_data)
 {
@@ -159,70 +86,6 @@ void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const
 	}
 }
 
-void upmix32bit_2_0_to_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data)
-{
-	uint32_t i;
-
-	channel_map out_channel_map = cd->out_channel_map;
-
-	/* Only load the channel if it's present. */
-	ae_int32 *output_left = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LEFT) << 2));
-	ae_int32 *output_center = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_CENTER) << 2));
-	ae_int32 *output_right = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_RIGHT) << 2));
-	ae_int32 *output_left_surround = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LEFT_SURROUND) << 2));
-	ae_int32 *output_right_surround = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_RIGHT_SURROUND) << 2));
-	ae_int32 *output_lfe = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LFE) << 2));
-	ae_int32 *output_left_side = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_LEFT_SIDE) << 2));
-	ae_int32 *output_right_side = (ae_int32 *)(out_data +
-		(get_channel_location(out_channel_map, CHANNEL_RIGHT_SIDE) << 2));
-
-	ae_int32 *in_left_ptr = (ae_int32 *)in_data;
-	ae_int32 *in_right_ptr = (ae_int32 *)(in_data + 4);
-
-	for (i = 0; i < (in_size >> 3); ++i) {
-		output_left[i * 8] = in_left_ptr[i * 2];
-		output_right[i * 8] = in_right_ptr[i * 2];
-		output_center[i * 8] = 0;
-		output_left_surround[i * 8] = in_left_ptr[i * 2];
-		output_right_surround[i * 8] = in_right_ptr[i * 2];
-		output_lfe[i * 8] = 0;
-		output_left_side[i * 8] = 0;
-		output_right_side[i * 8] = 0;
-	}
-}
-
-void shiftcopy32bit_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data)
-{
-	size_t i;
-
-	ae_p24f *in_ptr = (ae_p24f *)in_data;
-	ae_p24x2f *out_ptr = (ae_p24x2f *)out_data;
-
-	for (i = 0; i < (in_size >> 2); ++i)
-		out_ptr[i] = in_ptr[i];
-}
-
-void shiftcopy32bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data)
-{
-	uint32_t i;
-
-	ae_p24x2f *in_ptr = (ae_p24x2f *)in_data;
-	ae_p24x2f *out_ptr = (ae_p24x2f *)out_data;
-
-	for (i = 0; i < (in_size >> 3); ++i)
-		out_ptr[i] = in_ptr[i];
-}
-
 void downmix32bit_2_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 		      const uint32_t in_size, uint8_t * const out_data)
 {
@@ -1919,48 +1782,18 @@ void upmix32bit_quatro_to_5_1(struct up_down_mixer_data *cd, const uint8_t * con
 
 /* TODO: replace with generic ANSI C version */
 
-void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data)
-{
-	sof_panic(0);
-}
-
 void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			 const uint32_t in_size, uint8_t * const out_data)
 {
 	sof_panic(0);
 }
 
-void upmix32bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data)
-{
-	sof_panic(0);
-}
-
 void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			   const uint32_t in_size, uint8_t * const out_data)
 {
 	sof_panic(0);
 }
 
-void upmix32bit_2_0_to_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data)
-{
-	sof_panic(0);
-}
-
-void shiftcopy32bit_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data)
-{
-	sof_panic(0);
-}
-
-void shiftcopy32bit_stereo(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			   const uint32_t in_size, uint8_t * const out_data)
-{
-	sof_panic(0);
-}
-
 void downmix32bit_2_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 		      const uint32_t in_size, uint8_t * const out_data)
 {
@@ -8,8 +8,10 @@
  * a static per-core array is queued accordingly. The secondary core is then
  * woken up, it executes irc_handler(), which eventually calls idc_cmd() just
  * like in the native SOF case. One work item per secondary core is enough
- * because IDC on SOF is always synchronous, the primary core always waits for
- * secondary cores to complete operation, so no races can occur.
+ * because IDC on SOF is synchronous, the primary core always waits for a
+ * secondary core to complete an operation before sending it the next one, so
+ * no races can occur. With IDC_ASYNC the wait is only deferred, which lets
+ * several secondary cores process messages in parallel.
  *
  * Design:
  * - use K_P4WQ_ARRAY_DEFINE() to statically create one queue with one thread
@@ -59,6 +61,11 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 	return -ENOTSUP;
 }
 
+int idc_wait_msg(uint32_t core)
+{
+	return -ENOTSUP;
+}
+
 #else
 
 K_P4WQ_ARRAY_DEFINE(q_zephyr_idc, CONFIG_CORE_COUNT, SOF_STACK_SIZE,
@@ -131,7 +138,7 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 	work->priority = EDF_ZEPHYR_PRIORITY;
 	work->deadline = 0;
 	work->handler = idc_handler;
-	work->sync = mode == IDC_BLOCKING;
+	work->sync = mode == IDC_BLOCKING || mode == IDC_ASYNC;
 
 	if (!cpu_is_core_enabled(target_cpu)) {
 		tr_err(&zephyr_idc_tr, "Core %u is down, cannot sent IDC message", target_cpu);
@@ -162,6 +169,7 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 		break;
 	case IDC_POWER_UP:
 	case IDC_NON_BLOCKING:
+	case IDC_ASYNC:
 	default:
 		ret = 0;
 	}
@@ -169,6 +177,24 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 	return ret;
 }
 
+/*
+ * Waits for a message sent with IDC_ASYNC to the target core. Several cores
+ * can process such messages in parallel but only one message per target core
+ * can be in flight, it has to be collected before the next one is sent.
+ */
+int idc_wait_msg(uint32_t core)
+{
+	struct k_p4wq_work *work = &idc_work[core].work;
+	int ret;
+
+	ret = k_p4wq_wait(work, K_USEC(IDC_TIMEOUT));
+	if (!ret)
+		/* message was executed, get status code */
+		ret = idc_msg_status_get(core);
+
+	return ret;
+}
+
 void idc_init_thread(void)
 {
 	int cpu = cpu_get_id();
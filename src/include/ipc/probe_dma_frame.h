@@ -30,7 +30,7 @@ struct probe_data_packet {
  * Audio format from extraction probes is encoded as 32 bit value. Following
  * graphic explains encoding.
  *
- * A|BBBB|CCCC|DDDD|EEEEE|FF|GG|H|I|J|XXXXXXX
+ * A|BBBB|CCCC|DDDD|EEEEE|FF|GG|H|I|J|K|LLLL|XX
  * A - 1 bit - Specifies Type Encoding - 1 for Standard encoding
  * B - 4 bits - Specify Standard Type - 0 for Audio
  * C - 4 bits - Specify Audio format - 0 for PCM
@@ -57,6 +57,20 @@ struct probe_data_packet {
  * H - 1 bit - Specifies Sample Format - 0 for Integer, 1 for Floating point
  * I - 1 bit - Specifies Sample Endianness - 0 for LE
  * J - 1 bit - Specifies Interleaving - 1 for Sample Interleaving
+ * K - 1 bit - Specifies Compression - 1 for delta coded samples
+ * L - 4 bits - Specify Decimation factor minus 1, sample rate of the
+ *		packet data is the sample rate D divided by the factor
+ *
+ * Number of Channels E is the number of extracted channels, it is lower than
+ * the channel count of the probed buffer when only a subset is extracted.
+ *
+ * Delta coded data keeps the sample order of interleaved data. Each sample is
+ * coded as the difference to the previous sample of the same channel in the
+ * packet, the first sample of each channel as the difference to zero. The
+ * difference wrapped to the container size is zigzag mapped to an unsigned
+ * value, (d << 1) ^ (d >> (bits - 1)), and stored as a little endian base 128
+ * varint: 7 bits per byte, bit 7 set when more bytes follow. Every packet can
+ * be decoded on its own and the number of samples follows from the data size.
  */
 #define PROBE_SHIFT_FMT_TYPE		31
 #define PROBE_SHIFT_STANDARD_TYPE	27
@@ -68,6 +82,8 @@ struct probe_data_packet {
 #define PROBE_SHIFT_SAMPLE_FMT		9
 #define PROBE_SHIFT_SAMPLE_END		8
 #define PROBE_SHIFT_INTERLEAVING_ST	7
+#define PROBE_SHIFT_COMPRESSION		6
+#define PROBE_SHIFT_DECIMATION		2
 
 #define PROBE_MASK_FMT_TYPE		MASK(31, 31)
 #define PROBE_MASK_STANDARD_TYPE	MASK(30, 27)
@@ -79,5 +95,10 @@ struct probe_data_packet {
 #define PROBE_MASK_SAMPLE_FMT		MASK(9, 9)
 #define PROBE_MASK_SAMPLE_END		MASK(8, 8)
 #define PROBE_MASK_INTERLEAVING_ST	MASK(7, 7)
+#define PROBE_MASK_COMPRESSION		MASK(6, 6)
+#define PROBE_MASK_DECIMATION		MASK(5, 2)
+
+/** \brief Maximum decimation factor of extraction probe data */
+#define PROBE_DECIMATION_MAX		16
 
 #endif
@@ -46,6 +46,10 @@
 #define IPC4_PROBE_MODULE_INJECTION_DMA_DETACH	  2
 #define IPC4_PROBE_MODULE_PROBE_POINTS_ADD	  3
 #define IPC4_PROBE_MODULE_DISCONNECT_PROBE_POINTS 4
+#define IPC4_PROBE_MODULE_EXTRACTION_CONFIG	  5
+
+/** Compress extracted data, see probe_dma_frame.h */
+#define PROBE_EXTRACTION_FLAG_COMPRESS	BIT(0)
 
 /**
  * Description of probe dma
@@ -80,6 +84,16 @@ struct probe_point {
 				 */
 } __attribute__((packed, aligned(4)));
 
+/**
+ * Data reduction of extraction probe point
+ */
+struct probe_extraction_config {
+	probe_point_id_t buffer_id;	/**< ID of buffer of connected extraction probe */
+	uint32_t decimation;	/**< Extract one of 'decimation' frames, up to 16 */
+	uint32_t channel_mask;	/**< Bitmask of extracted channels */
+	uint32_t flags;		/**< PROBE_EXTRACTION_FLAG_xxx */
+} __packed __aligned(4);
+
 struct sof_ipc_probe_info_params {
 	uint32_t num_elems;				/**< Count of elements in array */
 	union {
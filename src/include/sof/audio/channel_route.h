@@ -0,0 +1,157 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2024 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/sof/audio/channel_route.h
+ * \brief Channel routing engine shared by mux, demux, selector and up_down_mixer
+ *
+ * A component describes its routing as a table of elements, each element
+ * connects one channel of one source stream to one sink channel with a gain.
+ * The table is compiled into a plan for the current stream layout, i.e. the
+ * frame format and the channel counts of the sink and of each source. Elements
+ * that do not fit the layout are dropped. The plan selects a processing
+ * function specialized for the kind of routing it contains: whole frame copy,
+ * per channel copy or weighted mix.
+ */
+
+#ifndef __SOF_AUDIO_CHANNEL_ROUTE_H__
+#define __SOF_AUDIO_CHANNEL_ROUTE_H__
+
+#include <sof/audio/audio_stream.h>
+#include <rtos/bit.h>
+#include <ipc/stream.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/** \brief Maximum number of routed sink channels and of taps per sink channel. */
+#define CHROUTE_MAX_CHANNELS	8
+
+/** \brief Maximum number of source streams. */
+#define CHROUTE_MAX_STREAMS	4
+
+/** \brief Route gains are Q6.10, same as the selector mixing coefficients. */
+#define CHROUTE_GAIN_SHIFT	10
+#define CHROUTE_UNITY_GAIN	BIT(CHROUTE_GAIN_SHIFT)
+
+/** \brief How elements routed to the same sink channel are combined. */
+enum chroute_mode {
+	CHROUTE_MODE_COPY = 0,	/**< the last element fitting the layout is copied */
+	CHROUTE_MODE_MIX,	/**< all elements are weighted and summed */
+};
+
+/** \brief Routing table element. */
+struct chroute_elem {
+	uint8_t stream;		/**< index of source stream */
+	uint8_t in_ch;		/**< source channel */
+	uint8_t out_ch;		/**< sink channel */
+	int16_t gain;		/**< Q6.10 gain, used in CHROUTE_MODE_MIX */
+};
+
+/** \brief Source channel weighted into a sink channel. */
+struct chroute_tap {
+	uint8_t stream;
+	uint8_t in_ch;
+	int16_t gain;
+};
+
+/** \brief Compiled routing of one sink channel, zero taps produce silence. */
+struct chroute_op {
+	uint8_t out_ch;
+	uint8_t num_taps;
+	struct chroute_tap tap[CHROUTE_MAX_CHANNELS];
+};
+
+struct chroute_plan;
+
+/**
+ * \brief Routing processing function for frames without wrap.
+ * \param[in] plan Compiled plan.
+ * \param[out] dst First sink frame.
+ * \param[in] src First frame of each source stream.
+ * \param[in] frames Number of frames.
+ */
+typedef void (*chroute_func)(const struct chroute_plan *plan, void *dst,
+			     const void **src, uint32_t frames);
+
+/** \brief Routing plan compiled for a stream layout. */
+struct chroute_plan {
+	chroute_func func;	/**< NULL when plan must be compiled */
+	enum sof_ipc_frame frame_fmt;
+	uint8_t sink_channels;
+	uint8_t source_channels[CHROUTE_MAX_STREAMS];	/**< zero for absent stream */
+	uint8_t num_ops;
+	struct chroute_op op[CHROUTE_MAX_CHANNELS];
+};
+
+/**
+ * \brief Invalidates plan, it is compiled again on next chroute_plan_update().
+ * \param[in,out] plan Routing plan.
+ */
+static inline void chroute_plan_invalidate(struct chroute_plan *plan)
+{
+	plan->func = NULL;
+}
+
+/**
+ * \brief Compiles routing table into plan for the given stream layout.
+ * \param[in,out] plan Routing plan.
+ * \param[in] elems Routing table.
+ * \param[in] num_elems Number of routing table elements.
+ * \param[in] mode How elements to the same sink channel are combined.
+ * \param[in] frame_fmt Frame format of the sink and of all sources.
+ * \param[in] sink_channels Number of sink channels.
+ * \param[in] source_channels Channel count of each of CHROUTE_MAX_STREAMS
+ *			      sources, zero for an absent stream.
+ * \return Error code.
+ */
+int chroute_plan_compile(struct chroute_plan *plan, const struct chroute_elem *elems,
+			 int num_elems, enum chroute_mode mode, enum sof_ipc_frame frame_fmt,
+			 uint8_t sink_channels, const uint8_t *source_channels);
+
+/**
+ * \brief Compiles routing table into plan if the stream layout has changed.
+ * \param[in,out] plan Routing plan.
+ * \param[in] elems Routing table.
+ * \param[in] num_elems Number of routing table elements.
+ * \param[in] mode How elements to the same sink channel are combined.
+ * \param[in] sink Stream to write, provides format and channel count.
+ * \param[in] sources Source streams, NULL for an absent stream.
+ * \param[in] num_sources Number of source streams.
+ * \return Error code.
+ */
+int chroute_plan_update(struct chroute_plan *plan, const struct chroute_elem *elems,
+			int num_elems, enum chroute_mode mode,
+			const struct audio_stream *sink,
+			const struct audio_stream **sources, int num_sources);
+
+/**
+ * \brief Routes frames from source read pointers to sink write pointer.
+ *
+ * Read and write pointers of the streams are not updated. Sink channels
+ * that are not routed are not written.
+ *
+ * \param[in] plan Compiled routing plan.
+ * \param[in,out] sink Stream to write.
+ * \param[in] sources Source streams as passed to chroute_plan_update().
+ * \param[in] frames Number of frames to process.
+ */
+void chroute_process(const struct chroute_plan *plan, struct audio_stream *sink,
+		     const struct audio_stream **sources, uint32_t frames);
+
+/**
+ * \brief Routes frames between linear buffers that do not wrap.
+ * \param[in] plan Compiled routing plan.
+ * \param[out] dst First sink frame.
+ * \param[in] src First frame of each source stream.
+ * \param[in] frames Number of frames to process.
+ */
+static inline void chroute_process_frames(const struct chroute_plan *plan, void *dst,
+					  const void **src, uint32_t frames)
+{
+	if (plan->num_ops)
+		plan->func(plan, dst, src, frames);
+}
+
+#endif /* __SOF_AUDIO_CHANNEL_ROUTE_H__ */
@@ -15,8 +15,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
-/* __XCC__ is both for xt_xcc and xt_clang */
-#if defined(__XCC__)
+/* __XCC__ is both for xt_xcc and xt_clang. The HiFi versions support only
+ * the 16 bit FFT, the streaming mode uses the generic C version.
+ */
+#if defined(__XCC__) && !CONFIG_COMP_MFCC_STREAMING
 # include <xtensa/config/core-isa.h>
 # if XCHAL_HAVE_HIFI4
 #  define MFCC_HIFI4
@@ -34,9 +36,14 @@
 /* Set to 16 for lower RAM and MCPS with slightly lower quality. Set to 32 for best
  * quality but higher MCPS and RAM. The MFCC input is currently 16 bits. With this option
  * set to 32 the FFT and Mel filterbank are computed with better 32 bit precision. There
- * is also need to enable 32 bit FFT from Kconfig if set.
+ * is also need to enable 32 bit FFT from Kconfig if set. The streaming mode with two
+ * hops per FFT is always 32 bits.
  */
+#if CONFIG_COMP_MFCC_STREAMING
+#define MFCC_FFT_BITS	32
+#else
 #define MFCC_FFT_BITS	16
+#endif
 
 /* MFCC with 16 bit FFT benefits from data normalize, for 32 bits there's no
  * significant impact. The amount of left shifts for FFT input is limited to
@@ -90,6 +97,9 @@ struct mfcc_fft {
 	struct icomplex32 *fft_out; /**< fft_padded_size */
 #else
 #error "MFCC_FFT_BITS needs to be 16 or 32"
+#endif
+#if CONFIG_COMP_MFCC_STREAMING
+	struct icomplex32 *fft_spectra; /**< 2 x half_fft_size, separated hop pair spectra */
 #endif
 	struct fft_plan *fft_plan;
 	int fft_fill_start_idx; /**< Set to 0 for pad left, etc. */
@@ -121,6 +131,7 @@ struct mfcc_state {
 	int16_t *buffers;
 	int16_t *prev_data; /**< prev_data_size */
 	int16_t *window; /**< fft_size */
+	int16_t *out_data; /**< max_out_hops x out_size, output vectors */
 	int16_t *triangles;
 	int source_channel;
 	int buffer_size;
@@ -128,8 +139,14 @@ struct mfcc_state {
 	int low_freq;
 	int high_freq;
 	int sample_rate;
+	int out_size; /**< Number of output values per hop */
+	int max_out_hops; /**< Max number of hops per copy */
+	int out_pending; /**< Output vectors carried over to next period */
+	uint32_t dropped_hops; /**< Hops dropped for no room in output */
 	int waiting_fill:1; /**< booleans */
+	int dropping:1; /**< Hops were dropped in the last period */
 	int prev_samples_valid:1;
+	int mel_output:1; /**< Output log Mel energies instead of cepstral coefficients */
 	size_t sample_buffers_size; /**< bytes */
 };
 
@@ -49,6 +49,15 @@ struct ipc_msg;
 #define PPL_DIR_DOWNSTREAM	0
 #define PPL_DIR_UPSTREAM	1
 
+/*
+ * Entry of flat pipeline copy order.
+ */
+struct pipeline_copy_entry {
+	struct comp_dev *comp;	/**< component to copy */
+	uint16_t skip;		/**< index of first entry after the subtree */
+	uint16_t run;		/**< component copied in current period, upstream */
+};
+
 /*
  * Audio pipeline.
  */
@@ -84,6 +93,19 @@ struct pipeline {
 
 	struct list_item list;	/**< list in walk context */
 
+	/* flat copy order, built on prepare, see pipeline_copy_order_build() */
+	struct pipeline_copy_entry *copy_order;	/* graph walk order */
+	uint16_t *copy_post;			/* upstream copy order of entries */
+	uint32_t copy_count;			/* number of entries */
+	bool copy_order_valid;			/* graph unchanged since build */
+
+#if CONFIG_XRUN_PREDICTION
+	/* xrun prediction, see pipeline_xrun_predict() */
+	uint32_t xrun_margin_min;	/* lowest DMA margin in current window */
+	uint32_t xrun_margin_count;	/* copies in current window */
+	bool xrun_predicted;		/* waiting for margin to recover */
+#endif
+
 	/* position update */
 	uint32_t posn_offset;		/* position update array offset*/
 	struct ipc_msg *msg;
@@ -295,6 +317,35 @@ int pipeline_trigger_run(struct pipeline *p, struct comp_dev *host, int cmd);
  */
 int pipeline_copy(struct pipeline *p);
 
+/**
+ * \brief Builds flat copy order of pipeline components.
+ *
+ * The order is the order of the pipeline graph walk done by pipeline_copy().
+ * Every period pipeline_copy() iterates over the order instead of walking
+ * the graph. Connecting or disconnecting a component of the pipeline
+ * invalidates the order until it is built again.
+ *
+ * \param[in] p pipeline.
+ * \return 0 on success.
+ */
+int pipeline_copy_order_build(struct pipeline *p);
+
+/**
+ * \brief Frees flat copy order of pipeline components.
+ * \param[in] p pipeline.
+ */
+void pipeline_copy_order_free(struct pipeline *p);
+
+/**
+ * \brief Invalidates flat copy order after graph change.
+ * \param[in] p pipeline, can be NULL.
+ */
+static inline void pipeline_copy_order_invalidate(struct pipeline *p)
+{
+	if (p)
+		p->copy_order_valid = false;
+}
+
 /**
  * \brief Get time pipeline timestamps from host to dai.
  * \param[in] p pipeline.
@@ -432,4 +483,34 @@ void pipeline_xrun(struct pipeline *p, struct comp_dev *dev, int32_t bytes);
  */
 int pipeline_xrun_set_limit(struct pipeline *p, uint32_t xrun_limit_usecs);
 
+#if CONFIG_XRUN_PREDICTION
+/**
+ * \brief Checks DMA buffer margin of endpoint for an upcoming xrun.
+ *
+ * Raises NOTIFIER_ID_XRUN_PREDICTED once the margin drops below
+ * CONFIG_XRUN_PREDICTION_MARGIN_PCT of the DMA buffer size.
+ *
+ * \param[in] p pipeline.
+ * \param[in] dev Endpoint component device.
+ * \param[in] margin Bytes left before xrun after the copy.
+ * \param[in] size DMA buffer size in bytes.
+ */
+void pipeline_xrun_predict(struct pipeline *p, struct comp_dev *dev,
+			   uint32_t margin, uint32_t size);
+
+/**
+ * \brief Restarts xrun prediction of pipeline.
+ * \param[in] p pipeline.
+ */
+static inline void pipeline_xrun_predict_reset(struct pipeline *p)
+{
+	p->xrun_margin_count = 0;
+	p->xrun_predicted = false;
+}
+#else
+static inline void pipeline_xrun_predict(struct pipeline *p, struct comp_dev *dev,
+					 uint32_t margin, uint32_t size) { }
+static inline void pipeline_xrun_predict_reset(struct pipeline *p) { }
+#endif
+
 #endif /* __SOF_AUDIO_PIPELINE_H__ */
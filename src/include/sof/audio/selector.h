@@ -18,6 +18,7 @@
 #include <sof/trace/trace.h>
 #include <ipc/stream.h>
 #if CONFIG_IPC_MAJOR_4
+#include <sof/audio/channel_route.h>
 #include <ipc4/base-config.h>
 #endif
 #include <user/selector.h>
@@ -109,6 +110,9 @@ struct comp_data {
 #if CONFIG_IPC_MAJOR_4
 	struct sof_selector_ipc4_config sel_ipc4_cfg;
 	struct ipc4_selector_coeffs_config coeffs_config;
+	/** coefficients as routing table, sink channel major */
+	struct chroute_elem routes[SEL_SINK_CHANNELS_MAX * SEL_SOURCE_CHANNELS_MAX];
+	struct chroute_plan plan;	/**< routing plan compiled from routes */
 #endif
 
 	uint32_t source_period_bytes;	/**< source number of period bytes */
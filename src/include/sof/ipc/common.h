@@ -50,6 +50,10 @@ extern struct tr_ctx ipc_tr;
 #define IPC_TASK_SECONDARY_CORE	BIT(2)
 #define IPC_TASK_POWERDOWN      BIT(3)
 
+/* number of buckets of the component indexes */
+#define IPC_COMP_HASH_BITS	5
+#define IPC_COMP_HASH_SIZE	BIT(IPC_COMP_HASH_BITS)
+
 struct ipc {
 	struct k_spinlock lock;	/* locking mechanism */
 	void *comp_data;
@@ -63,6 +67,8 @@ struct ipc {
 	unsigned int core;		/* core, processing the IPC */
 
 	struct list_item comp_list;	/* list of component devices */
+	struct list_item comp_hash[IPC_COMP_HASH_SIZE];	/* devices by ID */
+	struct list_item ppl_hash[IPC_COMP_HASH_SIZE];	/* devices by pipeline ID */
 
 	/* processing task */
 	struct task ipc_task;
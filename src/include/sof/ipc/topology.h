@@ -97,6 +97,8 @@ struct ipc_comp_dev {
 
 	/* lists */
 	struct list_item list;		/* list in components */
+	struct list_item hash_list;	/* list in ID index bucket */
+	struct list_item ppl_list;	/* list in pipeline ID index bucket */
 };
 
 /**
@@ -171,6 +173,20 @@ int ipc_comp_connect(struct ipc *ipc, ipc_pipe_comp_connect *connect);
  */
 int ipc_comp_disconnect(struct ipc *ipc, ipc_pipe_comp_connect *connect);
 
+/**
+ * \brief Add component device to the component list and indexes.
+ * @param ipc The global IPC context.
+ * @param icd The component device, its type, ID and pipeline ID must be set.
+ */
+void ipc_comp_dev_add(struct ipc *ipc, struct ipc_comp_dev *icd);
+
+/**
+ * \brief Remove component device from the component list and indexes.
+ * @param ipc The global IPC context.
+ * @param icd The component device.
+ */
+void ipc_comp_dev_del(struct ipc *ipc, struct ipc_comp_dev *icd);
+
 /**
  * \brief Get component device from component type and ID.
  * @param ipc The global IPC context.
@@ -190,6 +206,14 @@ struct ipc_comp_dev *ipc_get_comp_dev(struct ipc *ipc, uint16_t type, uint32_t i
  */
 struct ipc_comp_dev *ipc_get_comp_by_ppl_id(struct ipc *ipc, uint16_t type,
 					    uint32_t ppl_id, uint32_t ignore_remote);
+/**
+ * \brief Get pipeline ID index bucket, its devices are linked by ppl_list.
+ * @param ipc The global IPC context.
+ * @param pipeline_id The pipeline ID.
+ * @return Bucket list, may contain devices of other pipelines too.
+ */
+struct list_item *ipc_get_ppl_list(struct ipc *ipc, uint32_t pipeline_id);
+
 /**
  * \brief Get buffer device from pipeline ID.
  * @param ipc The global IPC context.
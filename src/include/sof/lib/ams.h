@@ -119,6 +119,8 @@ struct ams_shared_context {
 	uint32_t slot_uses[CONFIG_CORE_COUNT];
 	/* marks which core already processed slot */
 	uint32_t slot_done[CONFIG_CORE_COUNT];
+	/* slots queued to each core, one IDC announces all slots queued until handled */
+	uint32_t slot_pending[CONFIG_CORE_COUNT];
 
 	struct ams_slot slots[CONFIG_CORE_COUNT];
 };
@@ -131,7 +133,6 @@ struct ams_context {
 struct ams_task {
 	struct task ams_task;
 	struct async_message_service *ams;
-	uint32_t pending_slots;
 };
 
 struct async_message_service {
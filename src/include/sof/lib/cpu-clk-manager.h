@@ -18,12 +18,27 @@
 #include <rtos/sof.h>
 #include <stdint.h>
 
+/**
+ * \brief Measured load of a core.
+ */
+struct kcps_load {
+	uint64_t window_start;	/* Start of measurement window */
+	uint32_t busy;		/* Scheduler busy time in current window */
+	int kcps;		/* Budget from measured load, 0 if not measured yet */
+	int low_peak;		/* Highest budget during low load windows */
+	unsigned int low_windows;	/* Consecutive windows below budget */
+};
+
 /**
  * \brief CPS budget data.
  */
 struct kcps_budget_data {
 	/* uncache only */
 	int kcps_consumption[CONFIG_CORE_COUNT];	/* Sum of declared consumptions on core */
+#if CONFIG_KCPS_GOVERNOR
+	int kcps_pinned[CONFIG_CORE_COUNT];	/* Part of consumptions not scaled to load */
+	struct kcps_load load[CONFIG_CORE_COUNT];
+#endif
 	struct k_spinlock lock;
 };
 
@@ -40,6 +55,19 @@ struct kcps_budget_data {
  */
 int core_kcps_adjust(int core, int kcps_delta);
 
+/**
+ * \brief Declare pinned KCPS usage on core
+ *
+ * Same as core_kcps_adjust() but the declared consumption is not lowered
+ * to the measured load of the core. Meant for work not accounted by LL and
+ * DP schedulers, e.g. done in the IPC thread. Pinned consumption must be
+ * freed with this function too.
+ *
+ * @param core The core to which consumption should be pinned
+ * @param kcps_delta declared usage. Can be negative.
+ */
+int core_kcps_pin(int core, int kcps_delta);
+
 /**
  * \brief Get KCPS usage on core
  *
@@ -49,6 +77,24 @@ int core_kcps_adjust(int core, int kcps_delta);
  */
 int core_kcps_get(int core);
 
+#if CONFIG_KCPS_GOVERNOR
+/**
+ * \brief Account scheduler busy time on core
+ *
+ * Adds time spent processing to the measured load of the core. When the
+ * measurement window expires the core budget is reevaluated and the CPU
+ * clock adjusted. Preemptible contexts pass their own runtime only, so
+ * time they were preempted is not counted twice.
+ *
+ * @param core The core which was busy
+ * @param busy Processing time in sof_cycle_get_64() ticks
+ * @param end sof_cycle_get_64() stamp at the end of processing
+ */
+void core_kcps_account(int core, uint64_t busy, uint64_t end);
+#else
+static inline void core_kcps_account(int core, uint64_t busy, uint64_t end) { }
+#endif
+
 /**
  * \brief Init KCPS budget mechanism
  */
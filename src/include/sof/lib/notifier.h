@@ -34,11 +34,18 @@ enum notify_id {
 	NOTIFIER_ID_LL_POST_RUN,		/* NULL */
 	NOTIFIER_ID_DMA_IRQ,			/* struct dma_chan_data * */
 	NOTIFIER_ID_DAI_TRIGGER,		/* struct dai_group * */
+	NOTIFIER_ID_XRUN_PREDICTED,		/* NULL */
 	NOTIFIER_ID_COUNT
 };
 
+/* callback handles filtering on caller are hashed into per type buckets */
+#define NOTIFIER_CALLER_HASH_BITS	2
+#define NOTIFIER_CALLER_HASH_SIZE	BIT(NOTIFIER_CALLER_HASH_BITS)
+
 struct notify {
-	struct list_item list[NOTIFIER_ID_COUNT]; /* list of callback handles */
+	struct list_item list[NOTIFIER_ID_COUNT]; /* callback handles without caller */
+	struct list_item caller_list[NOTIFIER_ID_COUNT][NOTIFIER_CALLER_HASH_SIZE];
+	uint32_t count[NOTIFIER_ID_COUNT]; /* number of callback handles */
 	struct k_spinlock lock;	/* list lock */
 };
 
@@ -101,6 +101,11 @@ struct lib_manager_mod_ctx {
 	void *base_addr;
 	const struct sof_man_module_manifest *mod_manifest;
 	struct lib_manager_segment_desc segment[LIB_MANAGER_N_SEGMENTS];
+#if CONFIG_LIBRARY_MANAGER_KEEP_IDLE
+	bool mapped;		/* LLEXT segments are mapped */
+	bool in_use;		/* library has module instances */
+	uint64_t last_use;	/* time the last instance was freed */
+#endif
 };
 
 struct ext_library {
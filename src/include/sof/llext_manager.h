@@ -6,6 +6,7 @@
 #ifndef __SOF_LLEXT_MANAGER_H__
 #define __SOF_LLEXT_MANAGER_H__
 
+#include <errno.h>
 #include <stdint.h>
 
 struct comp_driver;
@@ -23,4 +24,26 @@ int llext_manager_free_module(const uint32_t component_id);
 #define llext_unload(ext) 0
 #endif
 
+#if CONFIG_LIBRARY_MANAGER_KEEP_IDLE
+/*
+ * \brief Unmaps the least recently used idle library.
+ *
+ * Called when mapping memory pages fails, the caller retries the mapping.
+ *
+ * \return 0 when a library was unmapped, -ENOMEM when there is none.
+ */
+int llext_manager_evict_idle(void);
+
+/*
+ * \brief Unmaps an idle library before it is loaded again.
+ *
+ * \param[in] lib_id Library ID.
+ * \return 0 on success, -EBUSY when the library has module instances.
+ */
+int llext_manager_release_library(uint32_t lib_id);
+#else
+#define llext_manager_evict_idle() (-ENOMEM)
+#define llext_manager_release_library(lib_id) 0
+#endif
+
 #endif
@@ -23,6 +23,21 @@ struct mat_matrix_16b {
 	int16_t data[];
 };
 
+/* Matrix in compressed sparse row (CSR) format. Only the non-zero values are
+ * stored row by row to data[] and their column indices to column[]. The
+ * row_start[] has for each row the index of its first value in data[], and
+ * row_start[rows] is the number of stored values.
+ */
+struct mat_sparse_16b {
+	int16_t rows;
+	int16_t columns;
+	int16_t fractions;
+	int16_t num_values;
+	int16_t *row_start;
+	int16_t *column;
+	int16_t data[];
+};
+
 static inline void mat_init_16b(struct mat_matrix_16b *mat, int16_t rows, int16_t columns,
 				int16_t fractions)
 {
@@ -80,4 +95,23 @@ int mat_multiply(struct mat_matrix_16b *a, struct mat_matrix_16b *b, struct mat_
 int mat_multiply_elementwise(struct mat_matrix_16b *a, struct mat_matrix_16b *b,
 			     struct mat_matrix_16b *c);
 
+/**
+ * \brief Allocate a sparse matrix and initialize it from the non-zero
+ * values of a dense matrix.
+ * \param[in] mat  Dense matrix to convert.
+ * \return         Pointer to sparse matrix, NULL if allocation failed.
+ */
+struct mat_sparse_16b *mat_sparse_alloc_from_16b(struct mat_matrix_16b *mat);
+
+/**
+ * \brief Multiply sparse matrix a with dense matrix b, c = a * b. The zero
+ * values of a are skipped.
+ * \param[in]  a  Sparse matrix.
+ * \param[in]  b  Dense matrix.
+ * \param[out] c  Dense result matrix.
+ * \return        Zero if success, -EINVAL if matrix sizes do not match.
+ */
+int mat_multiply_sparse(struct mat_sparse_16b *a, struct mat_matrix_16b *b,
+			struct mat_matrix_16b *c);
+
 #endif /* __SOF_MATH_MATRIX_H__ */
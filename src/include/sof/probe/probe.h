@@ -97,6 +97,21 @@ int probe_point_info(struct sof_ipc_probe_info_params *data, uint32_t max_size);
  */
 int probe_point_remove(uint32_t count, const uint32_t *buffer_id);
 
+#if CONFIG_IPC_MAJOR_4 && CONFIG_PROBE_EXTRACTION_REDUCE
+/*
+ * \brief Set data reduction of extraction probe points
+ *
+ * Decimation, channel subset and compression apply to connected extraction
+ * probe points until they are removed. Decimation must divide the sample rate
+ * of the probed buffer. Data extracted before the call keeps the full format,
+ * the extracted stream changes format in the packet that follows the call.
+ *
+ * param[in] count - number of probe points configured this call
+ * param[in] cfg - array of size 'count' with configuration of probe points
+ */
+int probe_extraction_config(uint32_t count, const struct probe_extraction_config *cfg);
+#endif
+
 /**
  * \brief Retrieves probes structure.
  * \return Pointer to probes structure.
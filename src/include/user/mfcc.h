@@ -80,7 +80,7 @@ struct sof_mfcc_config {
 	bool snip_edges; /**< Must be true (1) */
 	bool subtract_mean; /**< Must be false (0) */
 	bool use_energy; /**< Must be false (0) */
-	bool reserved_bool1;
+	bool mel_output; /**< Output log Mel energies, DCT and lifter are not applied */
 	bool reserved_bool2;
 	bool reserved_bool3;
 } __attribute__((packed));
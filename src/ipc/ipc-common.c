@@ -78,6 +78,32 @@ int ipc_process_on_core(uint32_t core, bool blocking)
 	return 1;
 }
 
+/* IPC4 IDs keep the instance in the upper half, mix it into the bucket index */
+static inline struct list_item *ipc_comp_hash_bucket(struct list_item *hash, uint32_t id)
+{
+	return &hash[(id * 0x9E3779B1u) >> (32 - IPC_COMP_HASH_BITS)];
+}
+
+/*
+ * Besides the component list every device is kept in two indexes, by its ID
+ * and by its pipeline ID, so lookups don't need to walk all devices. Bucket
+ * lists keep the order of the component list.
+ */
+void ipc_comp_dev_add(struct ipc *ipc, struct ipc_comp_dev *icd)
+{
+	list_item_append(&icd->list, &ipc->comp_list);
+	list_item_append(&icd->hash_list, ipc_comp_hash_bucket(ipc->comp_hash, icd->id));
+	list_item_append(&icd->ppl_list,
+			 ipc_comp_hash_bucket(ipc->ppl_hash, ipc_comp_pipe_id(icd)));
+}
+
+void ipc_comp_dev_del(struct ipc *ipc, struct ipc_comp_dev *icd)
+{
+	list_item_del(&icd->list);
+	list_item_del(&icd->hash_list);
+	list_item_del(&icd->ppl_list);
+}
+
 /*
  * Components, buffers and pipelines are stored in the same lists, hence
  * type and ID have to be used for the identification.
@@ -87,8 +113,8 @@ struct ipc_comp_dev *ipc_get_comp_dev(struct ipc *ipc, uint16_t type, uint32_t i
 	struct ipc_comp_dev *icd;
 	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, ipc_comp_hash_bucket(ipc->comp_hash, id)) {
+		icd = container_of(clist, struct ipc_comp_dev, hash_list);
 		if (icd->id == id && (type == icd->type || type == COMP_TYPE_ANY))
 			return icd;
 	}
@@ -96,6 +122,11 @@ struct ipc_comp_dev *ipc_get_comp_dev(struct ipc *ipc, uint16_t type, uint32_t i
 	return NULL;
 }
 
+struct list_item *ipc_get_ppl_list(struct ipc *ipc, uint32_t pipeline_id)
+{
+	return ipc_comp_hash_bucket(ipc->ppl_hash, pipeline_id);
+}
+
 /* Walks through the list of components looking for a sink/source endpoint component
  * of the given pipeline
  */
@@ -107,8 +138,8 @@ struct ipc_comp_dev *ipc_get_ppl_comp(struct ipc *ipc, uint32_t pipeline_id, int
 	struct list_item *clist, *blist;
 	struct ipc_comp_dev *next_ppl_icd = NULL;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, ipc_get_ppl_list(ipc, pipeline_id)) {
+		icd = container_of(clist, struct ipc_comp_dev, ppl_list);
 		if (icd->type != COMP_TYPE_COMPONENT)
 			continue;
 
@@ -265,6 +296,8 @@ void ipc_schedule_process(struct ipc *ipc)
 
 int ipc_init(struct sof *sof)
 {
+	int i;
+
 	tr_dbg(&ipc_tr, "ipc_init()");
 
 	/* init ipc data */
@@ -275,6 +308,10 @@ int ipc_init(struct sof *sof)
 	k_spinlock_init(&sof->ipc->lock);
 	list_init(&sof->ipc->msg_list);
 	list_init(&sof->ipc->comp_list);
+	for (i = 0; i < IPC_COMP_HASH_SIZE; i++) {
+		list_init(&sof->ipc->comp_hash[i]);
+		list_init(&sof->ipc->ppl_hash[i]);
+	}
 
 #ifdef __ZEPHYR__
 	k_work_init_delayable(&sof->ipc->z_delayed_work, ipc_work_handler);
@@ -558,6 +558,61 @@ const struct ipc4_pipeline_set_state_data *ipc4_get_pipeline_data_wrapper(void)
 	return ppl_data;
 }
 
+/* Pipeline state requests to secondary cores are sent without waiting for
+ * completion, so pipelines on different cores change state in parallel. Only
+ * one request per core can be in flight, an earlier one is collected before
+ * the next one is sent to the same core.
+ *
+ * Triggers keep the order of the pipeline list between cores that depend on
+ * each other's order: requests in flight are collected before a pipeline of
+ * this core is triggered, and this core waits for its delayed triggers before
+ * it goes on with the list. Only a run of consecutive remote pipelines is
+ * triggered in parallel. Those start on the next LL tick of their own cores,
+ * which are not aligned with each other, so a blocking send would not order
+ * their start either.
+ */
+static int ipc4_ppl_state_send(uint32_t *pending, uint32_t core, uint32_t ppl_id,
+			       uint32_t phase, uint32_t *cmd)
+{
+	struct idc_msg msg = { IDC_MSG_PPL_STATE,
+		IDC_MSG_PPL_STATE_EXT(ppl_id, phase),
+		core, sizeof(*cmd), cmd, };
+	int ret;
+
+	if (*pending & BIT(core)) {
+		*pending &= ~BIT(core);
+		ret = idc_wait_msg(core);
+		if (ret != 0)
+			return ret;
+	}
+
+	ret = idc_send_msg(&msg, IDC_ASYNC);
+	if (ret == 0)
+		*pending |= BIT(core);
+
+	return ret;
+}
+
+/* Collects all requests in flight, returns the first error */
+static int ipc4_ppl_state_collect(uint32_t *pending, int ret)
+{
+	uint32_t core;
+	int err;
+
+	for (core = 0; core < CONFIG_CORE_COUNT; core++) {
+		if (!(*pending & BIT(core)))
+			continue;
+
+		err = idc_wait_msg(core);
+		if (err != 0 && ret == 0)
+			ret = err;
+	}
+
+	*pending = 0;
+
+	return ret;
+}
+
 static int ipc4_set_pipeline_state(struct ipc4_message_request *ipc4)
 {
 	const struct ipc4_pipeline_set_state_data *ppl_data;
@@ -568,6 +623,7 @@ static int ipc4_set_pipeline_state(struct ipc4_message_request *ipc4)
 	uint32_t id = 0;
 	const uint32_t *ppl_id;
 	bool use_idc = false;
+	uint32_t pending = 0;
 	uint32_t idx;
 	int ret = 0;
 	int i;
@@ -610,32 +666,32 @@ static int ipc4_set_pipeline_state(struct ipc4_message_request *ipc4)
 						 ppl_id[i], IPC_COMP_IGNORE_REMOTE);
 		if (!ppl_icd) {
 			ipc_cmd_err(&ipc_tr, "ipc: comp %d not found", ppl_id[i]);
-			return IPC4_INVALID_RESOURCE_ID;
+			ret = IPC4_INVALID_RESOURCE_ID;
+			goto out;
 		}
 
 		/* Pass IPC to target core
 		 * or use idc if more than one core used
 		 */
 		if (!cpu_is_me(ppl_icd->core)) {
-			if (use_idc) {
-				struct idc_msg msg = { IDC_MSG_PPL_STATE,
-					IDC_MSG_PPL_STATE_EXT(ppl_id[i],
-							      IDC_PPL_STATE_PHASE_PREPARE),
-					ppl_icd->core,
-					sizeof(cmd), &cmd, };
-
-				ret = idc_send_msg(&msg, IDC_BLOCKING);
-			} else {
+			if (use_idc)
+				ret = ipc4_ppl_state_send(&pending, ppl_icd->core, ppl_id[i],
+							  IDC_PPL_STATE_PHASE_PREPARE, &cmd);
+			else
 				return ipc4_process_on_core(ppl_icd->core, false);
-			}
 		} else {
 			ret = ipc4_pipeline_prepare(ppl_icd, cmd);
 		}
 
 		if (ret != 0)
-			return ret;
+			goto out;
 	}
 
+	/* all pipelines must be prepared before any of them is triggered */
+	ret = ipc4_ppl_state_collect(&pending, ret);
+	if (ret != 0)
+		return ret;
+
 	/* Run the trigger phase on the pipelines */
 	for (i = 0; i < ppl_count; i++) {
 		bool delayed = false;
@@ -644,25 +700,25 @@ static int ipc4_set_pipeline_state(struct ipc4_message_request *ipc4)
 						 ppl_id[i], IPC_COMP_IGNORE_REMOTE);
 		if (!ppl_icd) {
 			ipc_cmd_err(&ipc_tr, "ipc: comp %d not found", ppl_id[i]);
-			return IPC4_INVALID_RESOURCE_ID;
+			ret = IPC4_INVALID_RESOURCE_ID;
+			goto out;
 		}
 
 		/* Pass IPC to target core
 		 * or use idc if more than one core used
 		 */
 		if (!cpu_is_me(ppl_icd->core)) {
-			if (use_idc) {
-				struct idc_msg msg = { IDC_MSG_PPL_STATE,
-					IDC_MSG_PPL_STATE_EXT(ppl_id[i],
-							      IDC_PPL_STATE_PHASE_TRIGGER),
-					ppl_icd->core,
-					sizeof(cmd), &cmd, };
-
-				ret = idc_send_msg(&msg, IDC_BLOCKING);
-			} else {
+			if (use_idc)
+				ret = ipc4_ppl_state_send(&pending, ppl_icd->core, ppl_id[i],
+							  IDC_PPL_STATE_PHASE_TRIGGER, &cmd);
+			else
 				return ipc4_process_on_core(ppl_icd->core, false);
-			}
 		} else {
+			/* remote pipelines earlier in the list are triggered first */
+			ret = ipc4_ppl_state_collect(&pending, 0);
+			if (ret != 0)
+				goto out;
+
 			ipc_compound_pre_start(state.primary.r.type);
 			ret = ipc4_pipeline_trigger(ppl_icd, cmd, &delayed);
 			ipc_compound_post_start(state.primary.r.type, ret, delayed);
@@ -670,20 +726,23 @@ static int ipc4_set_pipeline_state(struct ipc4_message_request *ipc4)
 				/* To maintain pipeline order for triggers, we must
 				 * do a blocking wait until trigger is processed.
 				 * This will add a max delay of 'ppl_count' LL ticks
-				 * to process the full trigger list.
+				 * to process the full trigger list. Remote triggers
+				 * are ordered against it by ipc4_ppl_state_collect().
 				 */
 				if (ipc_wait_for_compound_msg() != 0) {
 					ipc_cmd_err(&ipc_tr, "ipc4: fail with delayed trigger");
-					return IPC4_FAILURE;
+					ret = IPC4_FAILURE;
+					goto out;
 				}
 			}
 		}
 
 		if (ret != 0)
-			return ret;
+			goto out;
 	}
 
-	return ret;
+out:
+	return ipc4_ppl_state_collect(&pending, ret);
 }
 
 #if CONFIG_LIBRARY_MANAGER
@@ -750,7 +809,7 @@ static int ipc4_process_chain_dma(struct ipc4_message_request *ipc4)
 		return IPC4_INVALID_CHAIN_STATE_TRANSITION;
 
 	if (!cdma.primary.r.allocate && !cdma.primary.r.enable)
-		list_item_del(&cdma_comp->list);
+		ipc_comp_dev_del(ipc, cdma_comp);
 
 	return IPC4_SUCCESS;
 #else
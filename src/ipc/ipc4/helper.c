@@ -168,8 +168,8 @@ struct ipc_comp_dev *ipc_get_comp_by_ppl_id(struct ipc *ipc, uint16_t type,
 	struct ipc_comp_dev *icd;
 	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, ipc_get_ppl_list(ipc, ppl_id)) {
+		icd = container_of(clist, struct ipc_comp_dev, ppl_list);
 		if (icd->type != type)
 			continue;
 
@@ -233,7 +233,7 @@ static int ipc4_create_pipeline(struct ipc4_pipeline_create *pipe_desc)
 	ipc_pipe->pipeline->attributes = pipe_desc->extension.r.attributes;
 
 	/* add new pipeline to the list */
-	list_item_append(&ipc_pipe->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, ipc_pipe);
 
 	return IPC4_SUCCESS;
 }
@@ -338,7 +338,7 @@ int ipc_pipeline_free(struct ipc *ipc, uint32_t comp_id)
 	}
 
 	ipc_pipe->pipeline = NULL;
-	list_item_del(&ipc_pipe->list);
+	ipc_comp_dev_del(ipc, ipc_pipe);
 	rfree(ipc_pipe);
 
 	return IPC4_SUCCESS;
@@ -796,7 +796,7 @@ int ipc4_chain_dma_state(struct comp_dev *dev, struct ipc4_chain_dma *cdma)
 			icd = container_of(clist, struct ipc_comp_dev, list);
 			if (icd->cd != dev)
 				continue;
-			list_item_del(&icd->list);
+			ipc_comp_dev_del(ipc, icd);
 			rfree(icd);
 			break;
 		}
@@ -812,8 +812,8 @@ static int ipc4_update_comps_direction(struct ipc *ipc, uint32_t ppl_id)
 	struct list_item *clist;
 	struct comp_buffer *src_buf;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, ipc_get_ppl_list(ipc, ppl_id)) {
+		icd = container_of(clist, struct ipc_comp_dev, ppl_list);
 		if (icd->type != COMP_TYPE_COMPONENT)
 			continue;
 
@@ -1069,7 +1069,7 @@ int ipc4_add_comp_dev(struct comp_dev *dev)
 
 	tr_dbg(&ipc_tr, "ipc4_add_comp_dev add comp 0x%x", icd->id);
 	/* add new component to the list */
-	list_item_append(&icd->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, icd);
 
 	return IPC4_SUCCESS;
 };
@@ -278,6 +278,32 @@ int ams_unregister_consumer(uint32_t message_type_id,
 	return err;
 }
 
+/*
+ * Releases the slots queued to a core whose IDC could not be sent. While the
+ * failed slot is still queued every other queued slot came in behind this
+ * kick and nothing would process them. Once the core has taken the failed
+ * slot the remaining ones belong to a later kick and are left to it.
+ */
+static void ams_drop_pending(struct ams_shared_context __sparse_cache *ctx_shared,
+			     uint32_t core_id, uint32_t failed_slot, uint32_t target_core)
+{
+	uint32_t pending = ctx_shared->slot_pending[core_id];
+	uint32_t slot;
+
+	if (!(pending & BIT(failed_slot)))
+		return;
+
+	ctx_shared->slot_pending[core_id] = 0;
+	ctx_shared->slot_done[failed_slot] |= BIT(target_core);
+
+	while (pending) {
+		slot = 31 - clz(pending);
+		pending &= ~BIT(slot);
+
+		ctx_shared->slot_uses[slot]--;
+	}
+}
+
 static uint32_t ams_push_slot(struct ams_shared_context __sparse_cache *ctx_shared,
 			      const struct ams_message_payload *msg,
 			      uint16_t module_id, uint16_t instance_id)
@@ -357,6 +383,7 @@ static int ams_message_send_internal(struct async_message_service *ams,
 	uint32_t forwarded = 0;
 	uint32_t slot;
 	struct ams_consumer_entry ams_target;
+	bool kick = false;
 	int ixc_route;
 	int cpu_id;
 	int err = 0;
@@ -421,6 +448,10 @@ static int ams_message_send_internal(struct async_message_service *ams,
 				if (slot != AMS_INVALID_SLOT) {
 					shared_c->slot_uses[slot]++;
 					shared_c->slot_done[slot] |= BIT(cpu_id);
+
+					/* IDC is needed only if the core has no slots queued */
+					kick = !shared_c->slot_pending[ixc_route];
+					shared_c->slot_pending[ixc_route] |= BIT(slot);
 				}
 
 				/* release lock here, so other core can acquire it again */
@@ -428,12 +459,12 @@ static int ams_message_send_internal(struct async_message_service *ams,
 
 				if (slot != AMS_INVALID_SLOT) {
 					forwarded |= BIT(ams_target.consumer_core_id);
-					err = ams_send_over_ixc(ams, slot, &ams_target);
+					err = kick ? ams_send_over_ixc(ams, slot, &ams_target) : 0;
 					if (err != 0) {
-						/* idc not sent, update slot refs locally */
+						/* idc not sent, drop everything queued behind it */
 						shared_c = ams_acquire(ams->ams_context->shared);
-						shared_c->slot_uses[slot]--;
-						shared_c->slot_done[slot] |= BIT(ams_target.consumer_core_id);
+						ams_drop_pending(shared_c, ixc_route, slot,
+								 ams_target.consumer_core_id);
 						ams_release(shared_c);
 					}
 				}
@@ -505,22 +536,14 @@ static int ams_process_slot(struct async_message_service *ams, uint32_t slot)
 
 #if CONFIG_SMP
 
-static void ams_task_add_slot_to_process(struct ams_task *ams_task, uint32_t slot)
-{
-	int flags;
-
-	irq_local_disable(flags);
-	ams_task->pending_slots |= BIT(slot);
-	irq_local_enable(flags);
-}
-
+/* The slot is queued in the shared context already, together with any other
+ * slots sent to this core before the task runs.
+ */
 int process_incoming_message(uint32_t slot)
 {
 	struct async_message_service *ams = *arch_ams_get();
 	struct ams_task *task = &ams->ams_task;
 
-	ams_task_add_slot_to_process(task, slot);
-
 	return schedule_task(&task->ams_task, 0, 10000);
 }
 
@@ -528,25 +551,27 @@ int process_incoming_message(uint32_t slot)
 
 /* ams task */
 
+/* Processes all slots queued to this core, they may come with a single IDC */
 static enum task_state process_message(void *arg)
 {
 	struct ams_task *ams_task = arg;
+	struct ams_shared_context __sparse_cache *shared_c;
+	uint32_t pending;
 	uint32_t slot;
-	int flags;
 
-	if (ams_task->pending_slots == 0) {
-		tr_err(&ams_tr, "Could not process message! Skipping.");
-		return SOF_TASK_STATE_COMPLETED;
-	}
+	shared_c = ams_acquire(ams_task->ams->ams_context->shared);
+	pending = shared_c->slot_pending[cpu_get_id()];
+	shared_c->slot_pending[cpu_get_id()] = 0;
+	ams_release(shared_c);
 
-	slot = 31 - clz(ams_task->pending_slots);
+	/* nothing left if an earlier run has taken the slots of this IDC */
+	while (pending) {
+		slot = 31 - clz(pending);
+		pending &= ~BIT(slot);
 
-	ams_process_slot(ams_task->ams, slot);
+		ams_process_slot(ams_task->ams, slot);
+	}
 
-	/* only done on main core, irq disabling is enough */
-	irq_local_disable(flags);
-	ams_task->pending_slots &= ~BIT(slot);
-	irq_local_enable(flags);
 	schedule_task_cancel(&ams_task->ams_task);
 
 	return SOF_TASK_STATE_COMPLETED;
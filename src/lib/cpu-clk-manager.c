@@ -8,9 +8,12 @@
 #include <rtos/sof.h>
 #include <stdint.h>
 #include <sof/lib/cpu-clk-manager.h>
+#include <sof/lib/notifier.h>
 #include <rtos/clk.h>
+#include <rtos/timer.h>
 #include <sof/math/numbers.h>
 #include <errno.h>
+#include <stdbool.h>
 #ifdef __ZEPHYR__
 #include <zephyr/sys/util.h>
 #endif /* __ZEPHYR__ */
@@ -38,26 +41,38 @@ static int request_freq_change(unsigned int core, int freq)
 	return 0;
 }
 
+static int core_budget(unsigned int core)
+{
+	int kcps = kcps_data.kcps_consumption[core];
+
+#if CONFIG_KCPS_GOVERNOR
+	/* measured load can only lower the declared budget, the pinned part is kept */
+	kcps -= kcps_data.kcps_pinned[core];
+	if (kcps_data.load[core].kcps)
+		kcps = MIN(kcps, kcps_data.load[core].kcps);
+	kcps += kcps_data.kcps_pinned[core];
+#endif
+
+	return kcps;
+}
+
 static int max_core_consumption(void)
 {
 	int result = 0;
 	unsigned int core;
 
 	for (core = 0; core < CONFIG_CORE_COUNT; core++)
-		result = MAX(result, kcps_data.kcps_consumption[core]);
+		result = MAX(result, core_budget(core));
 
 	return result;
 }
 
-int core_kcps_adjust(int adjusted_core_id, int kcps_delta)
+/* must be called with kcps_data.lock held */
+static int set_cores_freq(void)
 {
-	k_spinlock_key_t key;
 	int freq;
 	unsigned int core_id;
-	int ret = 0;
-
-	key = k_spin_lock(&kcps_data.lock);
-	kcps_data.kcps_consumption[adjusted_core_id] += kcps_delta;
+	int ret;
 
 	/* set clock according to maximum requested mcps budget */
 	freq = max_core_consumption();
@@ -66,15 +81,109 @@ int core_kcps_adjust(int adjusted_core_id, int kcps_delta)
 		/* Convert kcps to cps */
 		ret = request_freq_change(core_id, MIN(freq * 1000, CLK_MAX_CPU_HZ));
 		if (ret < 0)
-			goto out;
+			return ret;
 	}
 
-out:
+	return 0;
+}
+
+static int kcps_adjust(int adjusted_core_id, int kcps_delta, bool pinned)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	key = k_spin_lock(&kcps_data.lock);
+	kcps_data.kcps_consumption[adjusted_core_id] += kcps_delta;
+
+#if CONFIG_KCPS_GOVERNOR
+	if (pinned)
+		kcps_data.kcps_pinned[adjusted_core_id] += kcps_delta;
+
+	/* new load runs with its declared budget until it is measured */
+	if (kcps_delta > 0 && !pinned) {
+		kcps_data.load[adjusted_core_id].kcps = 0;
+		kcps_data.load[adjusted_core_id].low_windows = 0;
+	}
+#endif
+
+	ret = set_cores_freq();
+
 	k_spin_unlock(&kcps_data.lock, key);
 
 	return ret;
 }
 
+int core_kcps_adjust(int adjusted_core_id, int kcps_delta)
+{
+	return kcps_adjust(adjusted_core_id, kcps_delta, false);
+}
+
+int core_kcps_pin(int adjusted_core_id, int kcps_delta)
+{
+	return kcps_adjust(adjusted_core_id, kcps_delta, true);
+}
+
+#if CONFIG_KCPS_GOVERNOR
+/* Returns true if budget of the core has changed, window is in sof_cycle_get_64() ticks */
+static bool kcps_governor_update(unsigned int core, uint64_t window)
+{
+	struct kcps_load *load = &kcps_data.load[core];
+	int kcps;
+
+	/* busy share of the window at current clock plus headroom */
+	kcps = (uint64_t)load->busy * (clock_get_freq(core) / 1000) / window;
+	kcps = MAX(kcps * (100 + CONFIG_KCPS_GOVERNOR_HEADROOM_PCT) / 100, 1);
+
+	/* raise without delay, an underestimated budget leads to xruns */
+	if (!load->kcps || kcps >= load->kcps) {
+		load->low_windows = 0;
+		if (kcps == load->kcps)
+			return false;
+
+		load->kcps = kcps;
+		return true;
+	}
+
+	load->low_peak = load->low_windows ? MAX(load->low_peak, kcps) : kcps;
+	if (++load->low_windows < CONFIG_KCPS_GOVERNOR_DOWN_WINDOWS)
+		return false;
+
+	load->low_windows = 0;
+	load->kcps = load->low_peak;
+	return true;
+}
+
+void core_kcps_account(int core, uint64_t busy, uint64_t end)
+{
+	struct kcps_load *load = &kcps_data.load[core];
+	k_spinlock_key_t key;
+	uint64_t window;
+
+	/* LL and DP threads of the same core account concurrently */
+	key = k_spin_lock(&kcps_data.lock);
+
+	load->busy += busy;
+
+	if (!load->window_start) {
+		load->window_start = end - busy;
+		goto out;
+	}
+
+	window = end - load->window_start;
+	if (window < k_ms_to_cyc_ceil64(CONFIG_KCPS_GOVERNOR_WINDOW_MS))
+		goto out;
+
+	if (kcps_governor_update(core, window))
+		set_cores_freq();
+
+	load->busy = 0;
+	load->window_start = end;
+
+out:
+	k_spin_unlock(&kcps_data.lock, key);
+}
+#endif
+
 int core_kcps_get(int core)
 {
 	k_spinlock_key_t key;
@@ -86,9 +195,31 @@ int core_kcps_get(int core)
 	return ret;
 }
 
+#if CONFIG_KCPS_GOVERNOR && CONFIG_XRUN_PREDICTION
+/* measured load missed a peak, use declared budgets until it is measured again */
+static void kcps_governor_xrun_predicted(void *arg, enum notify_id type, void *data)
+{
+	k_spinlock_key_t key;
+	unsigned int core;
+
+	key = k_spin_lock(&kcps_data.lock);
+	for (core = 0; core < CONFIG_CORE_COUNT; core++) {
+		kcps_data.load[core].kcps = 0;
+		kcps_data.load[core].low_windows = 0;
+	}
+	set_cores_freq();
+	k_spin_unlock(&kcps_data.lock, key);
+}
+#endif
+
 int kcps_budget_init(void)
 {
 	k_spinlock_init(&kcps_data.lock);
 
+#if CONFIG_KCPS_GOVERNOR && CONFIG_XRUN_PREDICTION
+	return notifier_register(&kcps_data, NULL, NOTIFIER_ID_XRUN_PREDICTED,
+				 kcps_governor_xrun_predicted, 0);
+#else
 	return 0;
+#endif
 }
@@ -37,24 +37,40 @@ struct callback_handle {
 	uint32_t num_registrations;
 };
 
+/* Returns list of callback handles of given type registered for caller */
+static struct list_item *notifier_caller_list(struct notify *notify,
+					      enum notify_id type, const void *caller)
+{
+	uint32_t hash;
+
+	if (!caller)
+		return &notify->list[type];
+
+	hash = ((uint32_t)(uintptr_t)caller * 0x9E3779B1u) >>
+		(32 - NOTIFIER_CALLER_HASH_BITS);
+
+	return &notify->caller_list[type][hash];
+}
+
 int notifier_register(void *receiver, void *caller, enum notify_id type,
 		      void (*cb)(void *arg, enum notify_id type, void *data),
 		      uint32_t flags)
 {
 	struct notify *notify = *arch_notify_get();
 	struct callback_handle *handle;
+	struct list_item *head;
 	k_spinlock_key_t key;
 	int ret = 0;
 
 	assert(type >= NOTIFIER_ID_CPU_FREQ && type < NOTIFIER_ID_COUNT);
 
+	head = notifier_caller_list(notify, type, caller);
+
 	key = k_spin_lock(&notify->lock);
 
-	/* Find already registered event of this type */
-	if (flags & NOTIFIER_FLAG_AGGREGATE &&
-	    !list_is_empty(&notify->list[type])) {
-		handle = container_of((&notify->list[type])->next,
-				      struct callback_handle, list);
+	/* Find already registered event of this type and caller index */
+	if (flags & NOTIFIER_FLAG_AGGREGATE && !list_is_empty(head)) {
+		handle = container_of(head->next, struct callback_handle, list);
 		handle->num_registrations++;
 
 		goto out;
@@ -74,20 +90,39 @@ int notifier_register(void *receiver, void *caller, enum notify_id type,
 	handle->cb = cb;
 	handle->num_registrations = 1;
 
-	list_item_prepend(&handle->list, &notify->list[type]);
+	list_item_prepend(&handle->list, head);
+	notify->count[type]++;
 
 out:
 	k_spin_unlock(&notify->lock, key);
 	return ret;
 }
 
-void notifier_unregister(void *receiver, void *caller, enum notify_id type)
+static void notifier_unregister_list(struct notify *notify, struct list_item *head,
+				     void *receiver, void *caller, enum notify_id type)
 {
-	struct notify *notify = *arch_notify_get();
 	struct list_item *wlist;
 	struct list_item *tlist;
 	struct callback_handle *handle;
+
+	list_for_item_safe(wlist, tlist, head) {
+		handle = container_of(wlist, struct callback_handle, list);
+		if ((!receiver || handle->receiver == receiver) &&
+		    (!caller || handle->caller == caller)) {
+			if (!--handle->num_registrations) {
+				list_item_del(&handle->list);
+				rfree(handle);
+				notify->count[type]--;
+			}
+		}
+	}
+}
+
+void notifier_unregister(void *receiver, void *caller, enum notify_id type)
+{
+	struct notify *notify = *arch_notify_get();
 	k_spinlock_key_t key;
+	int i;
 
 	assert(type >= NOTIFIER_ID_CPU_FREQ && type < NOTIFIER_ID_COUNT);
 
@@ -103,15 +138,14 @@ void notifier_unregister(void *receiver, void *caller, enum notify_id type)
 	 * Event consumer might unregister from all callers by passing caller
 	 * NULL
 	 */
-	list_for_item_safe(wlist, tlist, &notify->list[type]) {
-		handle = container_of(wlist, struct callback_handle, list);
-		if ((!receiver || handle->receiver == receiver) &&
-		    (!caller || handle->caller == caller)) {
-			if (!--handle->num_registrations) {
-				list_item_del(&handle->list);
-				rfree(handle);
-			}
-		}
+	if (caller) {
+		notifier_unregister_list(notify, notifier_caller_list(notify, type, caller),
+					 receiver, caller, type);
+	} else {
+		notifier_unregister_list(notify, &notify->list[type], receiver, NULL, type);
+		for (i = 0; i < NOTIFIER_CALLER_HASH_SIZE; i++)
+			notifier_unregister_list(notify, &notify->caller_list[type][i],
+						 receiver, NULL, type);
 	}
 
 	k_spin_unlock(&notify->lock, key);
@@ -125,29 +159,50 @@ void notifier_unregister_all(void *receiver, void *caller)
 		notifier_unregister(receiver, caller, i);
 }
 
-static void notifier_notify(const void *caller, enum notify_id type, void *data)
+static void notifier_notify_list(struct list_item *head, const void *caller,
+				 enum notify_id type, void *data)
 {
-	struct notify *notify = *arch_notify_get();
 	struct list_item *wlist;
 	struct list_item *tlist;
 	struct callback_handle *handle;
 
-	/* iterate through notifiers and send event to
-	 * interested clients
-	 */
-	list_for_item_safe(wlist, tlist, &notify->list[type]) {
+	list_for_item_safe(wlist, tlist, head) {
 		handle = container_of(wlist, struct callback_handle, list);
-		if (!caller || !handle->caller || handle->caller == caller)
+		if (!caller || handle->caller == caller)
 			handle->cb(handle->receiver, type, data);
 	}
 }
 
+static void notifier_notify(const void *caller, enum notify_id type, void *data)
+{
+	struct notify *notify = *arch_notify_get();
+	int i;
+
+	if (!notify->count[type])
+		return;
+
+	/* clients without caller filter are interested in all events,
+	 * the others only in events of their caller unless the event
+	 * has no caller
+	 */
+	notifier_notify_list(&notify->list[type], NULL, type, data);
+
+	if (caller) {
+		notifier_notify_list(notifier_caller_list(notify, type, caller),
+				     caller, type, data);
+		return;
+	}
+
+	for (i = 0; i < NOTIFIER_CALLER_HASH_SIZE; i++)
+		notifier_notify_list(&notify->caller_list[type][i], NULL, type, data);
+}
+
 void notifier_notify_remote(void)
 {
 	struct notify *notify = *arch_notify_get();
 	struct notify_data *notify_data = notify_data_get() + cpu_get_id();
 
-	if (!list_is_empty(&notify->list[notify_data->type])) {
+	if (notify->count[notify_data->type]) {
 		dcache_invalidate_region((__sparse_force void __sparse_cache *)notify_data->data,
 					 notify_data->data_size);
 		notifier_notify(notify_data->caller, notify_data->type,
@@ -163,6 +218,12 @@ void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 	struct idc_msg notify_msg = { IDC_MSG_NOTIFY, IDC_MSG_NOTIFY_EXT };
 	int i;
 
+	/* most events are local, no need to look at other cores */
+	if (core_mask == NOTIFIER_TARGET_CORE_LOCAL) {
+		notifier_notify(caller, type, data);
+		return;
+	}
+
 	/* notify selected targets */
 	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
 		if (core_mask & NOTIFIER_TARGET_CORE_MASK(i)) {
@@ -192,13 +253,16 @@ void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 void init_system_notify(struct sof *sof)
 {
 	struct notify **notify = arch_notify_get();
-	int i;
+	int i, j;
 	*notify = rzalloc(SOF_MEM_ZONE_SYS, SOF_MEM_FLAG_COHERENT, SOF_MEM_CAPS_RAM,
 			  sizeof(**notify));
 
 	k_spinlock_init(&(*notify)->lock);
-	for (i = NOTIFIER_ID_CPU_FREQ; i < NOTIFIER_ID_COUNT; i++)
+	for (i = NOTIFIER_ID_CPU_FREQ; i < NOTIFIER_ID_COUNT; i++) {
 		list_init(&(*notify)->list[i]);
+		for (j = 0; j < NOTIFIER_CALLER_HASH_SIZE; j++)
+			list_init(&(*notify)->caller_list[i][j]);
+	}
 
 	if (cpu_get_id() == PLATFORM_PRIMARY_CORE_ID)
 		sof->notify_data = platform_shared_get(notify_data_shared,
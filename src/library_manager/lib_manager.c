@@ -54,6 +54,8 @@ struct lib_manager_dma_ext {
 	struct dma *dma;
 	struct dma_chan_data *chan;
 	uintptr_t dma_addr;		/**< buffer start pointer */
+	uint32_t dma_size;		/**< buffer size, multiple of chunk size */
+	uint32_t rd_offset;		/**< next chunk offset in buffer */
 	uint32_t addr_align;
 };
 
@@ -134,9 +136,13 @@ static int lib_manager_auth_proc(const void *buffer_data,
 static int lib_manager_load_data_from_storage(void __sparse_cache *vma, void *s_addr, uint32_t size,
 					      uint32_t flags)
 {
+	int ret;
+
 	/* Region must be first mapped as writable in order to initialize its contents. */
-	int ret = sys_mm_drv_map_region((__sparse_force void *)vma, POINTER_TO_UINT(NULL), size,
-					SYS_MM_MEM_PERM_RW);
+	do {
+		ret = sys_mm_drv_map_region((__sparse_force void *)vma, POINTER_TO_UINT(NULL),
+					    size, SYS_MM_MEM_PERM_RW);
+	} while (ret == -ENOMEM && !llext_manager_evict_idle());
 	if (ret < 0)
 		return ret;
 
@@ -306,6 +312,7 @@ static int lib_manager_allocate_module_instance(uint32_t module_id, uint32_t ins
 			 * PAGE_SZ;
 	void __sparse_cache *va_base = lib_manager_get_instance_bss_address(module_id,
 									    instance_id, mod);
+	int ret;
 
 	if ((is_pages * PAGE_SZ) > bss_size) {
 		tr_err(&lib_manager_tr,
@@ -315,10 +322,13 @@ static int lib_manager_allocate_module_instance(uint32_t module_id, uint32_t ins
 	}
 
 	/*
-	 * Map bss memory and clear it.
+	 * Map bss memory and clear it, unmap idle libraries if pages run out.
 	 */
-	if (sys_mm_drv_map_region((__sparse_force void *)va_base, POINTER_TO_UINT(NULL),
-				  bss_size, SYS_MM_MEM_PERM_RW) < 0)
+	do {
+		ret = sys_mm_drv_map_region((__sparse_force void *)va_base, POINTER_TO_UINT(NULL),
+					    bss_size, SYS_MM_MEM_PERM_RW);
+	} while (ret == -ENOMEM && !llext_manager_evict_idle());
+	if (ret < 0)
 		return -ENOMEM;
 
 	memset((__sparse_force void *)va_base, 0, bss_size);
@@ -810,13 +820,20 @@ static int lib_manager_load_data_from_host(struct lib_manager_dma_ext *dma_ext,
 	return -ETIMEDOUT;
 }
 
+/*
+ * The DMA buffer is a ring of CONFIG_LIBRARY_MANAGER_DMA_BUFFERS chunks. The host
+ * DMA fills the following chunks while the current one is copied, a chunk is
+ * handed back to the DMA only after it has been copied.
+ */
 static int lib_manager_store_data(struct lib_manager_dma_ext *dma_ext,
 				  void __sparse_cache *dst_addr, uint32_t dst_size)
 {
 	uint32_t copied_bytes = 0;
 
 	while (copied_bytes < dst_size) {
+		uint8_t *dst = (__sparse_force uint8_t *)dst_addr + copied_bytes;
 		uint32_t bytes_to_copy;
+		uint32_t head;
 		int ret;
 
 		if ((dst_size - copied_bytes) > MAN_MAX_SIZE_V1_8)
@@ -828,8 +845,14 @@ static int lib_manager_store_data(struct lib_manager_dma_ext *dma_ext,
 		if (ret < 0)
 			return ret;
 
-		memcpy_s((__sparse_force uint8_t *)dst_addr + copied_bytes, bytes_to_copy,
-			 (void *)dma_ext->dma_addr, bytes_to_copy);
+		head = MIN(bytes_to_copy, dma_ext->dma_size - dma_ext->rd_offset);
+		memcpy_s(dst, bytes_to_copy, (void *)(dma_ext->dma_addr + dma_ext->rd_offset),
+			 head);
+		if (head < bytes_to_copy)
+			memcpy_s(dst + head, bytes_to_copy - head, (void *)dma_ext->dma_addr,
+				 bytes_to_copy - head);
+
+		dma_ext->rd_offset = (dma_ext->rd_offset + bytes_to_copy) % dma_ext->dma_size;
 		copied_bytes += bytes_to_copy;
 		dma_reload(dma_ext->chan->dma->z_dev, dma_ext->chan->index, 0, 0, bytes_to_copy);
 	}
@@ -933,7 +956,7 @@ static int lib_manager_setup(uint32_t dma_id)
 	struct ext_library *_ext_lib = ext_lib_get();
 	struct lib_manager_dma_ext *dma_ext;
 	struct dma_block_config dma_block_cfg = {
-		.block_size = MAN_MAX_SIZE_V1_8,
+		.block_size = MAN_MAX_SIZE_V1_8 * CONFIG_LIBRARY_MANAGER_DMA_BUFFERS,
 		.flow_control_mode = 1,
 	};
 	struct dma_config config = {
@@ -962,7 +985,8 @@ static int lib_manager_setup(uint32_t dma_id)
 	if (ret < 0)
 		goto err_dma_init;
 
-	ret = lib_manager_dma_buffer_alloc(dma_ext, MAN_MAX_SIZE_V1_8);
+	dma_ext->dma_size = dma_block_cfg.block_size;
+	ret = lib_manager_dma_buffer_alloc(dma_ext, dma_ext->dma_size);
 	if (ret < 0)
 		goto err_dma_buffer;
 
@@ -972,7 +996,7 @@ static int lib_manager_setup(uint32_t dma_id)
 	 * make sure that the DSP is running full speed for the duration of
 	 * library loading
 	 */
-	ret = core_kcps_adjust(cpu_get_id(), CLK_MAX_CPU_HZ / 1000);
+	ret = core_kcps_pin(cpu_get_id(), CLK_MAX_CPU_HZ / 1000);
 	if (ret < 0)
 		goto err_dma_buffer;
 
@@ -989,7 +1013,7 @@ static int lib_manager_setup(uint32_t dma_id)
 	return 0;
 
 err_dma:
-	core_kcps_adjust(cpu_get_id(), -(CLK_MAX_CPU_HZ / 1000));
+	core_kcps_pin(cpu_get_id(), -(CLK_MAX_CPU_HZ / 1000));
 
 err_dma_buffer:
 	lib_manager_dma_deinit(dma_ext, dma_id);
@@ -1028,6 +1052,14 @@ int lib_manager_load_library(uint32_t dma_id, uint32_t lib_id, uint32_t type)
 
 	dma_ext = _ext_lib->runtime_data;
 
+	/* A reloaded library gets a new context, unmap the idle old one first */
+	ret = llext_manager_release_library(lib_id);
+	if (ret < 0) {
+		tr_err(&lib_manager_tr,
+		       "lib_manager_load_library(): library %u still in use: %d", lib_id, ret);
+		goto cleanup;
+	}
+
 	/* allocate temporary manifest buffer */
 	man_tmp_buffer = (__sparse_force void __sparse_cache *)
 			rballoc_align(0, SOF_MEM_CAPS_DMA,
@@ -1067,7 +1099,7 @@ stop_dma:
 	rfree((__sparse_force void *)man_tmp_buffer);
 
 cleanup:
-	core_kcps_adjust(cpu_get_id(), -(CLK_MAX_CPU_HZ / 1000));
+	core_kcps_pin(cpu_get_id(), -(CLK_MAX_CPU_HZ / 1000));
 	rfree((void *)dma_ext->dma_addr);
 	lib_manager_dma_deinit(dma_ext, dma_id);
 	rfree(dma_ext);
@@ -17,6 +17,7 @@
 
 #include <rtos/sof.h>
 #include <rtos/spinlock.h>
+#include <rtos/timer.h>
 #include <sof/lib/cpu-clk-manager.h>
 #include <sof/lib_manager.h>
 #include <sof/llext_manager.h>
@@ -219,6 +220,133 @@ static int llext_manager_unload_module(uint32_t module_id, const struct sof_man_
 	return err;
 }
 
+#if CONFIG_LIBRARY_MANAGER_KEEP_IDLE
+/* Protects mapped, in_use and last_use of library contexts, eviction runs on
+ * any core when a page allocation fails
+ */
+static struct k_spinlock llext_lock;
+
+/* Resets writable data of a library that stayed mapped since its last use */
+static int llext_manager_reinit_data(struct lib_manager_mod_ctx *ctx)
+{
+	void __sparse_cache *va_base_data = (void __sparse_cache *)
+		ctx->segment[LIB_MANAGER_DATA].addr;
+	void *src_data = (uint8_t *)ctx->base_addr + ctx->segment[LIB_MANAGER_DATA].file_offset;
+	size_t data_size = ctx->segment[LIB_MANAGER_DATA].size;
+	void __sparse_cache *bss_addr = (void __sparse_cache *)
+		ctx->segment[LIB_MANAGER_BSS].addr;
+	size_t bss_size = ctx->segment[LIB_MANAGER_BSS].size;
+	int ret;
+
+	ret = memcpy_s((__sparse_force void *)va_base_data, data_size, src_data, data_size);
+	if (ret < 0)
+		return ret;
+
+	memset((__sparse_force void *)bss_addr, 0, bss_size);
+	dcache_writeback_region(va_base_data, data_size);
+	dcache_writeback_region(bss_addr, bss_size);
+
+	return 0;
+}
+
+int llext_manager_evict_idle(void)
+{
+	struct ext_library *_ext_lib = ext_lib_get();
+	struct lib_manager_mod_ctx *lru = NULL;
+	struct lib_manager_mod_ctx *ctx;
+	k_spinlock_key_t key;
+	uint32_t lru_id = 0;
+	uint32_t i;
+	int ret;
+
+	key = k_spin_lock(&llext_lock);
+
+	for (i = 0; i < LIB_MANAGER_MAX_LIBS; i++) {
+		ctx = _ext_lib->desc[i];
+		if (!ctx || !ctx->mapped || ctx->in_use)
+			continue;
+
+		if (!lru || ctx->last_use < lru->last_use) {
+			lru = ctx;
+			lru_id = i;
+		}
+	}
+
+	if (!lru) {
+		k_spin_unlock(&llext_lock, key);
+		return -ENOMEM;
+	}
+
+	tr_info(&lib_manager_tr, "llext_manager_evict_idle(): unmapping library %u", lru_id);
+
+	lru->mapped = false;
+	ret = llext_manager_unload_module(lru_id << LIB_MANAGER_LIB_ID_SHIFT, NULL);
+
+	k_spin_unlock(&llext_lock, key);
+
+	return ret;
+}
+
+int llext_manager_release_library(uint32_t lib_id)
+{
+	struct lib_manager_mod_ctx *ctx = ext_lib_get()->desc[lib_id];
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (!ctx)
+		return 0;
+
+	key = k_spin_lock(&llext_lock);
+
+	if (ctx->in_use) {
+		ret = -EBUSY;
+	} else if (ctx->mapped) {
+		ctx->mapped = false;
+		ret = llext_manager_unload_module(lib_id << LIB_MANAGER_LIB_ID_SHIFT, NULL);
+	}
+
+	k_spin_unlock(&llext_lock, key);
+
+	return ret;
+}
+#endif /* CONFIG_LIBRARY_MANAGER_KEEP_IDLE */
+
+static int llext_manager_map_module(uint32_t module_id, const struct sof_man_module *mod)
+{
+#if CONFIG_LIBRARY_MANAGER_KEEP_IDLE
+	struct lib_manager_mod_ctx *ctx = lib_manager_get_mod_ctx(module_id);
+	k_spinlock_key_t key;
+	bool mapped;
+	int ret;
+
+	/* in use library is not evicted while it is mapped */
+	key = k_spin_lock(&llext_lock);
+	mapped = ctx->mapped;
+	ctx->in_use = true;
+	k_spin_unlock(&llext_lock, key);
+
+	if (mapped) {
+		ret = llext_manager_reinit_data(ctx);
+	} else {
+		/* make room by unmapping idle libraries */
+		do {
+			ret = llext_manager_load_module(module_id, mod);
+		} while (ret == -ENOMEM && !llext_manager_evict_idle());
+	}
+
+	key = k_spin_lock(&llext_lock);
+	if (ret < 0)
+		ctx->in_use = false;
+	else
+		ctx->mapped = true;
+	k_spin_unlock(&llext_lock, key);
+
+	return ret;
+#else
+	return llext_manager_load_module(module_id, mod);
+#endif
+}
+
 static int llext_manager_link(struct sof_man_fw_desc *desc, struct sof_man_module *mod,
 			      uint32_t module_id, struct module_data *md, const void **buildinfo,
 			      const struct sof_man_module_manifest **mod_manifest)
@@ -332,7 +460,7 @@ uintptr_t llext_manager_allocate_module(struct processing_module *proc,
 		}
 
 		/* Map executable code and data */
-		ret = llext_manager_load_module(module_id, mod_array);
+		ret = llext_manager_map_module(module_id, mod_array);
 		if (ret < 0)
 			return 0;
 
@@ -361,5 +489,18 @@ int llext_manager_free_module(const uint32_t component_id)
 
 	mod = lib_manager_get_module_manifest(base_module_id);
 
+#if CONFIG_LIBRARY_MANAGER_KEEP_IDLE
+	struct lib_manager_mod_ctx *ctx = lib_manager_get_mod_ctx(base_module_id);
+	k_spinlock_key_t key;
+
+	/* Stays mapped for the next instance, unmapped when memory runs short */
+	key = k_spin_lock(&llext_lock);
+	ctx->in_use = false;
+	ctx->last_use = sof_cycle_get_64();
+	k_spin_unlock(&llext_lock, key);
+
+	return 0;
+#else
 	return llext_manager_unload_module(base_module_id, mod);
+#endif
 }
@@ -8,12 +8,27 @@
 #include <errno.h>
 #include <stdint.h>
 
+/* Number of output columns computed at a time. The inner loop then reads
+ * contiguous values from a row of matrix b and the accumulators for the
+ * block can be kept in registers.
+ */
+#define MAT_BLOCK_COLUMNS	4
+
+static inline int16_t mat_round_16b(int64_t s, int shift_minus_one)
+{
+	/* If all data is Q0 */
+	if (shift_minus_one == -1)
+		return (int16_t)s; /* For Q16.0 */
+
+	return (int16_t)(((s >> shift_minus_one) + 1) >> 1); /*Shift to Qx.y */
+}
+
 int mat_multiply(struct mat_matrix_16b *a, struct mat_matrix_16b *b, struct mat_matrix_16b *c)
 {
-	int64_t s;
-	int16_t *x;
+	int64_t s0, s1, s2, s3;
+	int32_t x;
 	int16_t *y;
-	int16_t *z = c->data;
+	int16_t *z;
 	int i, j, k;
 	int y_inc = b->columns;
 	const int shift_minus_one = a->fractions + b->fractions - c->fractions - 1;
@@ -21,40 +36,42 @@ int mat_multiply(struct mat_matrix_16b *a, struct mat_matrix_16b *b, struct mat_
 	if (a->columns != b->rows || a->rows != c->rows || b->columns != c->columns)
 		return -EINVAL;
 
-	/* If all data is Q0 */
-	if (shift_minus_one == -1) {
-		for (i = 0; i < a->rows; i++) {
-			for (j = 0; j < b->columns; j++) {
-				s = 0;
-				x = a->data + a->columns * i;
-				y = b->data + j;
-				for (k = 0; k < b->rows; k++) {
-					s += (int32_t)(*x) * (*y);
-					x++;
-					y += y_inc;
-				}
-				*z = (int16_t)s; /* For Q16.0 */
-				z++;
+	for (i = 0; i < a->rows; i++) {
+		z = c->data + c->columns * i;
+		for (j = 0; j + MAT_BLOCK_COLUMNS <= b->columns; j += MAT_BLOCK_COLUMNS) {
+			s0 = 0;
+			s1 = 0;
+			s2 = 0;
+			s3 = 0;
+			y = b->data + j;
+			for (k = 0; k < b->rows; k++) {
+				x = a->data[a->columns * i + k];
+				s0 += x * y[0];
+				s1 += x * y[1];
+				s2 += x * y[2];
+				s3 += x * y[3];
+				y += y_inc;
 			}
-		}
 
-		return 0;
-	}
+			z[j] = mat_round_16b(s0, shift_minus_one);
+			z[j + 1] = mat_round_16b(s1, shift_minus_one);
+			z[j + 2] = mat_round_16b(s2, shift_minus_one);
+			z[j + 3] = mat_round_16b(s3, shift_minus_one);
+		}
 
-	for (i = 0; i < a->rows; i++) {
-		for (j = 0; j < b->columns; j++) {
-			s = 0;
-			x = a->data + a->columns * i;
+		/* Remaining columns */
+		for (; j < b->columns; j++) {
+			s0 = 0;
 			y = b->data + j;
 			for (k = 0; k < b->rows; k++) {
-				s += (int32_t)(*x) * (*y);
-				x++;
+				s0 += (int32_t)a->data[a->columns * i + k] * *y;
 				y += y_inc;
 			}
-			*z = (int16_t)(((s >> shift_minus_one) + 1) >> 1); /*Shift to Qx.y */
-			z++;
+
+			z[j] = mat_round_16b(s0, shift_minus_one);
 		}
 	}
+
 	return 0;
 }
 
@@ -94,3 +111,99 @@ int mat_multiply_elementwise(struct mat_matrix_16b *a, struct mat_matrix_16b *b,
 
 	return 0;
 }
+
+struct mat_sparse_16b *mat_sparse_alloc_from_16b(struct mat_matrix_16b *mat)
+{
+	struct mat_sparse_16b *sparse;
+	size_t size;
+	int16_t *x = mat->data;
+	int num_values = 0;
+	int i, j;
+
+	for (i = 0; i < mat->rows * mat->columns; i++) {
+		if (x[i])
+			num_values++;
+	}
+
+	if (num_values > INT16_MAX)
+		return NULL;
+
+	/* The data[], column[], and row_start[] are allocated in this order in one block */
+	size = sizeof(struct mat_sparse_16b) +
+		sizeof(int16_t) * (2 * num_values + mat->rows + 1);
+	sparse = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!sparse)
+		return NULL;
+
+	sparse->rows = mat->rows;
+	sparse->columns = mat->columns;
+	sparse->fractions = mat->fractions;
+	sparse->num_values = num_values;
+	sparse->column = sparse->data + num_values;
+	sparse->row_start = sparse->column + num_values;
+
+	num_values = 0;
+	for (i = 0; i < mat->rows; i++) {
+		sparse->row_start[i] = num_values;
+		for (j = 0; j < mat->columns; j++) {
+			if (*x) {
+				sparse->data[num_values] = *x;
+				sparse->column[num_values] = j;
+				num_values++;
+			}
+
+			x++;
+		}
+	}
+
+	sparse->row_start[mat->rows] = num_values;
+	return sparse;
+}
+
+int mat_multiply_sparse(struct mat_sparse_16b *a, struct mat_matrix_16b *b,
+			struct mat_matrix_16b *c)
+{
+	int64_t s0, s1, s2, s3;
+	int32_t x;
+	int16_t *y;
+	int16_t *z;
+	int i, j, k;
+	const int shift_minus_one = a->fractions + b->fractions - c->fractions - 1;
+
+	if (a->columns != b->rows || a->rows != c->rows || b->columns != c->columns)
+		return -EINVAL;
+
+	for (i = 0; i < a->rows; i++) {
+		z = c->data + c->columns * i;
+		for (j = 0; j + MAT_BLOCK_COLUMNS <= b->columns; j += MAT_BLOCK_COLUMNS) {
+			s0 = 0;
+			s1 = 0;
+			s2 = 0;
+			s3 = 0;
+			for (k = a->row_start[i]; k < a->row_start[i + 1]; k++) {
+				x = a->data[k];
+				y = b->data + b->columns * a->column[k] + j;
+				s0 += x * y[0];
+				s1 += x * y[1];
+				s2 += x * y[2];
+				s3 += x * y[3];
+			}
+
+			z[j] = mat_round_16b(s0, shift_minus_one);
+			z[j + 1] = mat_round_16b(s1, shift_minus_one);
+			z[j + 2] = mat_round_16b(s2, shift_minus_one);
+			z[j + 3] = mat_round_16b(s3, shift_minus_one);
+		}
+
+		/* Remaining columns */
+		for (; j < b->columns; j++) {
+			s0 = 0;
+			for (k = a->row_start[i]; k < a->row_start[i + 1]; k++)
+				s0 += (int32_t)a->data[k] * b->data[b->columns * a->column[k] + j];
+
+			z[j] = mat_round_16b(s0, shift_minus_one);
+		}
+	}
+
+	return 0;
+}
@@ -19,6 +19,11 @@ static inline int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 	return 0;
 }
 
+static inline int idc_wait_msg(uint32_t core)
+{
+	return 0;
+}
+
 static inline void idc_process_msg_queue(void)
 {
 }
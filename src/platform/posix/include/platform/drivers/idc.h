@@ -15,4 +15,9 @@ static inline int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 	return 0;
 }
 
+static inline int idc_wait_msg(uint32_t core)
+{
+	return 0;
+}
+
 #endif /* PLATFORM_POSIX_DRIVERS_IDC_H */
@@ -12,6 +12,7 @@
 #include <user/trace.h>
 #include <rtos/alloc.h>
 #include <rtos/init.h>
+#include <rtos/spinlock.h>
 #include <sof/lib/dma.h>
 #include <sof/lib/notifier.h>
 #include <sof/lib/uuid.h>
@@ -79,6 +80,21 @@ struct probe_dma_ext {
 	struct dma_copy dc;		/**< DMA copy */
 };
 
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+#define PROBE_REDUCE_CHUNK_SIZE	1024	/**< max reduced data per packet */
+#define PROBE_VARINT_MAX_BYTES	5	/**< varint of 32-bit value */
+
+/**
+ * Extraction data reduction of probe point
+ */
+struct probe_reduce {
+	uint32_t decimation;	/**< one of decimation frames is extracted */
+	uint32_t channel_mask;	/**< extracted channels */
+	uint32_t flags;		/**< PROBE_EXTRACTION_FLAG_xxx */
+	uint32_t phase;		/**< frames to skip before next extracted one */
+};
+#endif
+
 /**
  * Probe main struct
  */
@@ -88,6 +104,12 @@ struct probe_pdata {
 	struct probe_point probe_points[CONFIG_PROBE_POINTS_MAX]; /**< probe points */
 	struct probe_data_packet header;			  /**< data packet header */
 	struct task dmap_work;					  /**< probe task */
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+	struct probe_reduce reduce[CONFIG_PROBE_POINTS_MAX];	  /**< extraction reduction */
+	struct k_spinlock reduce_lock;	/**< reduce set by IPC, used by probe_cb_produce() */
+	uint8_t reduced[PROBE_REDUCE_CHUNK_SIZE];		  /**< reduced frames */
+	uint8_t compressed[PROBE_REDUCE_CHUNK_SIZE + PROBE_VARINT_MAX_BYTES]; /**< coded frames */
+#endif
 };
 
 /**
@@ -363,6 +385,10 @@ int probe_init(const struct probe_dma *probe_dma)
 		return -ENOMEM;
 	}
 
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+	k_spinlock_init(&_probe->reduce_lock);
+#endif
+
 	/* setup extraction dma if requested */
 	if (probe_dma) {
 		tr_dbg(&pr_tr, "\tstream_tag = %u, dma_buffer_size = %u",
@@ -863,6 +889,168 @@ void probe_logging_hook(uint8_t *buffer, size_t length)
 }
 #endif
 
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+static void probe_reduce_reset(struct probe_reduce *reduce)
+{
+	reduce->decimation = 1;
+	reduce->channel_mask = MASK(31, 0);
+	reduce->flags = 0;
+	reduce->phase = 0;
+}
+
+static bool probe_reduce_active(const struct probe_reduce *reduce, uint32_t channels)
+{
+	uint32_t all = MASK(channels - 1, 0);
+
+	return reduce->decimation > 1 || (reduce->channel_mask & all) != all ||
+	       (reduce->flags & PROBE_EXTRACTION_FLAG_COMPRESS);
+}
+
+static inline uint8_t *probe_put_varint(uint8_t *out, uint32_t value)
+{
+	while (value >= 0x80) {
+		*out++ = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	*out++ = value;
+
+	return out;
+}
+
+/**
+ * \brief Delta code samples as described in probe_dma_frame.h.
+ * \param[in] in interleaved samples.
+ * \param[in] size samples size in bytes.
+ * \param[in] sample_bytes sample container size.
+ * \param[in] channels number of interleaved channels.
+ * \param[out] out coded data, size + PROBE_VARINT_MAX_BYTES bytes available.
+ * \return size of coded data or 0 if it is not smaller than samples.
+ */
+static uint32_t probe_compress(const uint8_t *in, uint32_t size, uint32_t sample_bytes,
+			       uint32_t channels, uint8_t *out)
+{
+	const int16_t *in16 = (const int16_t *)in;
+	const int32_t *in32 = (const int32_t *)in;
+	uint32_t samples = size / sample_bytes;
+	uint8_t *o = out;
+	uint32_t i;
+	int16_t d16;
+	int32_t d32;
+
+	for (i = 0; i < samples; i++) {
+		if (sample_bytes == sizeof(int16_t)) {
+			d16 = i < channels ? in16[i] : (int16_t)(in16[i] - in16[i - channels]);
+			o = probe_put_varint(o, (uint16_t)(((uint16_t)d16 << 1) ^ (d16 >> 15)));
+		} else {
+			d32 = i < channels ? in32[i] :
+			      (int32_t)((uint32_t)in32[i] - (uint32_t)in32[i - channels]);
+			o = probe_put_varint(o, ((uint32_t)d32 << 1) ^ (uint32_t)(d32 >> 31));
+		}
+
+		/* plain samples are sent when coding does not pay off */
+		if (o - out >= size)
+			return 0;
+	}
+
+	return o - out;
+}
+
+/**
+ * \brief Extract decimated channel subset of buffer data, optionally delta
+ *	  coded. Data is sent in packets of up to PROBE_REDUCE_CHUNK_SIZE bytes
+ *	  of reduced frames.
+ * \param[in] _probe probe main struct.
+ * \param[in,out] reduce reduction of probe point.
+ * \param[in] buffer_id component buffer id.
+ * \param[in] stream probed stream.
+ * \param[in] cb_data produced data.
+ * \return 0 on success, error code otherwise.
+ */
+static int probe_extract_reduced(struct probe_pdata *_probe, struct probe_reduce *reduce,
+				 uint32_t buffer_id, struct audio_stream *stream,
+				 const struct buffer_cb_transact *cb_data)
+{
+	uint32_t channels = audio_stream_get_channels(stream);
+	uint32_t mask = reduce->channel_mask & MASK(channels - 1, 0);
+	uint32_t sample_bytes = audio_stream_sample_bytes(stream);
+	uint32_t frame_bytes = audio_stream_frame_bytes(stream);
+	uint32_t frames = cb_data->transaction_amount / frame_bytes;
+	uint32_t out_channels = popcount(mask);
+	uint32_t max_frames;
+	uint8_t *src = cb_data->transaction_begin_address;
+	uint8_t *dst;
+	uint8_t *data;
+	uint32_t format;
+	uint32_t packet_format;
+	uint32_t size;
+	uint32_t coded;
+	uint32_t n;
+	uint32_t ch;
+	uint64_t checksum;
+	int ret;
+
+	if (!out_channels)
+		return 0;
+
+	max_frames = PROBE_REDUCE_CHUNK_SIZE / (out_channels * sample_bytes);
+	format = probe_gen_format(audio_stream_get_frm_fmt(stream),
+				  audio_stream_get_rate(stream), out_channels) |
+		 ((reduce->decimation - 1) << PROBE_SHIFT_DECIMATION);
+
+	while (frames) {
+		dst = _probe->reduced;
+		for (n = 0; frames && n < max_frames; frames--) {
+			if (reduce->phase) {
+				reduce->phase--;
+			} else {
+				for (ch = 0; ch < channels; ch++) {
+					if (!(mask & BIT(ch)))
+						continue;
+					if (sample_bytes == sizeof(int16_t))
+						*(int16_t *)dst = ((int16_t *)src)[ch];
+					else
+						*(int32_t *)dst = ((int32_t *)src)[ch];
+					dst += sample_bytes;
+				}
+				reduce->phase = reduce->decimation - 1;
+				n++;
+			}
+			src = audio_stream_wrap(stream, src + frame_bytes);
+		}
+
+		if (!n)
+			break;
+
+		data = _probe->reduced;
+		size = dst - _probe->reduced;
+		packet_format = format;
+		if (reduce->flags & PROBE_EXTRACTION_FLAG_COMPRESS) {
+			coded = probe_compress(_probe->reduced, size, sample_bytes,
+					       out_channels, _probe->compressed);
+			if (coded) {
+				data = _probe->compressed;
+				size = coded;
+				packet_format |= PROBE_MASK_COMPRESSION;
+			}
+		}
+
+		ret = probe_gen_header(buffer_id, size, packet_format, &checksum);
+		if (ret < 0)
+			return ret;
+
+		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb, data, size);
+		if (ret < 0)
+			return ret;
+
+		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb, &checksum, sizeof(checksum));
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_PROBE_EXTRACTION_REDUCE */
+
 /**
  * \brief General extraction probe callback, called from buffer produce.
  *	  It will search for probe point connected to this buffer.
@@ -887,6 +1075,9 @@ static void probe_cb_produce(void *arg, enum notify_id type, void *data)
 	uint32_t i, j;
 	uint32_t format;
 	uint64_t checksum;
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+	k_spinlock_key_t key;
+#endif
 
 	buffer_id = *(int *)arg;
 
@@ -902,6 +1093,21 @@ static void probe_cb_produce(void *arg, enum notify_id type, void *data)
 	}
 
 	if (_probe->probe_points[i].purpose == PROBE_PURPOSE_EXTRACTION) {
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+		key = k_spin_lock(&_probe->reduce_lock);
+		if (probe_reduce_active(&_probe->reduce[i],
+					audio_stream_get_channels(&buffer->stream))) {
+			ret = probe_extract_reduced(_probe, &_probe->reduce[i], buffer_id,
+						    &buffer->stream, cb_data);
+			k_spin_unlock(&_probe->reduce_lock, key);
+			if (ret < 0)
+				goto err;
+
+			kick_probe_task(_probe);
+			return;
+		}
+		k_spin_unlock(&_probe->reduce_lock, key);
+#endif
 		format = probe_gen_format(audio_stream_get_frm_fmt(&buffer->stream),
 					  audio_stream_get_rate(&buffer->stream),
 					  audio_stream_get_channels(&buffer->stream));
@@ -1274,6 +1480,9 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 		_probe->probe_points[first_free].buffer_id = *buf_id;
 		_probe->probe_points[first_free].purpose = probe[i].purpose;
 		_probe->probe_points[first_free].stream_tag = stream_tag;
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+		probe_reduce_reset(&_probe->reduce[first_free]);
+#endif
 
 		if (fw_logs) {
 #if CONFIG_LOG_BACKEND_SOF_PROBE
@@ -1444,6 +1653,71 @@ int probe_point_remove(uint32_t count, const uint32_t *buffer_id)
 }
 
 #if CONFIG_IPC_MAJOR_4
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+int probe_extraction_config(uint32_t count, const struct probe_extraction_config *cfg)
+{
+	struct probe_pdata *_probe = probe_get();
+	struct ipc_comp_dev *dev;
+	struct comp_buffer *buf;
+	k_spinlock_key_t key;
+	uint32_t rate;
+	uint32_t i;
+	uint32_t j;
+
+	if (!_probe) {
+		tr_err(&pr_tr, "probe_extraction_config(): Not initialized.");
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		tr_dbg(&pr_tr, "\tbuffer_id = %u, decimation = %u, channel_mask = %#x, flags = %#x",
+		       cfg[i].buffer_id.full_id, cfg[i].decimation, cfg[i].channel_mask,
+		       cfg[i].flags);
+
+		if (!cfg[i].decimation || cfg[i].decimation > PROBE_DECIMATION_MAX ||
+		    !cfg[i].channel_mask) {
+			tr_err(&pr_tr, "probe_extraction_config(): invalid config for buffer %u",
+			       cfg[i].buffer_id.full_id);
+			return -EINVAL;
+		}
+
+		for (j = 0; j < CONFIG_PROBE_POINTS_MAX; j++)
+			if (_probe->probe_points[j].stream_tag != PROBE_POINT_INVALID &&
+			    _probe->probe_points[j].purpose == PROBE_PURPOSE_EXTRACTION &&
+			    _probe->probe_points[j].buffer_id.full_id == cfg[i].buffer_id.full_id)
+				break;
+
+		if (j == CONFIG_PROBE_POINTS_MAX) {
+			tr_err(&pr_tr, "probe_extraction_config(): no extraction probe on buffer %u",
+			       cfg[i].buffer_id.full_id);
+			return -EINVAL;
+		}
+
+		/* decimated data must keep an integer sample rate */
+		dev = ipc_get_comp_by_id(ipc_get(),
+					 IPC4_COMP_ID(cfg[i].buffer_id.fields.module_id,
+						      cfg[i].buffer_id.fields.instance_id));
+		buf = dev ? ipc4_get_buffer(dev, cfg[i].buffer_id) : NULL;
+		rate = buf ? audio_stream_get_rate(&buf->stream) : 0;
+		if (rate % cfg[i].decimation) {
+			tr_err(&pr_tr, "probe_extraction_config(): decimation %u of rate %u for buffer %u",
+			       cfg[i].decimation, rate, cfg[i].buffer_id.full_id);
+			return -EINVAL;
+		}
+
+		/* the probe point may be extracting in LL meanwhile */
+		key = k_spin_lock(&_probe->reduce_lock);
+		_probe->reduce[j].decimation = cfg[i].decimation;
+		_probe->reduce[j].channel_mask = cfg[i].channel_mask;
+		_probe->reduce[j].flags = cfg[i].flags;
+		_probe->reduce[j].phase = 0;
+		k_spin_unlock(&_probe->reduce_lock, key);
+	}
+
+	return 0;
+}
+#endif
+
 static struct comp_dev *probe_new(const struct comp_driver *drv,
 				  const struct comp_ipc_config *config, const void *spec)
 {
@@ -1494,6 +1768,11 @@ static int probe_set_large_config(struct comp_dev *dev, uint32_t param_id,
 				     (const struct probe_dma *)data);
 	case IPC4_PROBE_MODULE_INJECTION_DMA_DETACH:
 		return probe_dma_remove(data_offset / sizeof(uint32_t), (const uint32_t *)data);
+#if CONFIG_PROBE_EXTRACTION_REDUCE
+	case IPC4_PROBE_MODULE_EXTRACTION_CONFIG:
+		return probe_extraction_config(data_offset / sizeof(struct probe_extraction_config),
+					       (const struct probe_extraction_config *)data);
+#endif
 	default:
 		return -EINVAL;
 	}
@@ -13,10 +13,12 @@
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
 #include <sof/trace/trace.h>
+#include <rtos/timer.h>
 #include <rtos/wait.h>
 #include <rtos/interrupt.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <sof/lib/cpu-clk-manager.h>
 #include <sof/lib/notifier.h>
 #include <ipc4/base_fw.h>
 
@@ -307,6 +309,10 @@ static void dp_thread_fn(void *p1, void *p2, void *p3)
 	struct task_dp_pdata *task_pdata = task->priv_data;
 	unsigned int lock_key;
 	enum task_state state;
+#if CONFIG_KCPS_GOVERNOR
+	k_thread_runtime_stats_t stats;
+	uint64_t begin_cycles;
+#endif
 
 	while (1) {
 		/*
@@ -315,10 +321,21 @@ static void dp_thread_fn(void *p1, void *p2, void *p3)
 		 */
 		k_sem_take(&task_pdata->sem, K_FOREVER);
 
-		if (task->state == SOF_TASK_STATE_RUNNING)
+		if (task->state == SOF_TASK_STATE_RUNNING) {
+#if CONFIG_KCPS_GOVERNOR
+			/* thread runtime leaves out LL and other threads preempting it */
+			k_thread_runtime_stats_get(k_current_get(), &stats);
+			begin_cycles = stats.execution_cycles;
+			state = task_run(task);
+			k_thread_runtime_stats_get(k_current_get(), &stats);
+			core_kcps_account(task->core, stats.execution_cycles - begin_cycles,
+					  sof_cycle_get_64());
+#else
 			state = task_run(task);
-		else
+#endif
+		} else {
 			state = task->state;	/* to avoid undefined variable warning */
+		}
 
 		lock_key = scheduler_dp_lock();
 		/*
@@ -16,6 +16,7 @@
 #include <zephyr/kernel.h>
 #include <ipc4/base_fw.h>
 #include <sof/debug/telemetry/telemetry.h>
+#include <sof/lib/cpu-clk-manager.h>
 
 LOG_MODULE_REGISTER(ll_schedule, CONFIG_SOF_LOG_LEVEL);
 
@@ -255,14 +256,18 @@ static void zephyr_ll_run(void *data)
 
 static void schedule_ll_callback(void *data)
 {
-#ifdef CONFIG_SOF_TELEMETRY
-	const uint32_t begin_stamp = (uint32_t)sof_cycle_get_64();
+#if defined(CONFIG_SOF_TELEMETRY) || CONFIG_KCPS_GOVERNOR
+	const uint64_t begin_stamp = sof_cycle_get_64();
 #endif
 	zephyr_ll_run(data);
+#if defined(CONFIG_SOF_TELEMETRY) || CONFIG_KCPS_GOVERNOR
+	const uint64_t current_stamp = sof_cycle_get_64();
+#endif
 #ifdef CONFIG_SOF_TELEMETRY
-	const uint32_t current_stamp = (uint32_t)sof_cycle_get_64();
-
-	telemetry_update(begin_stamp, current_stamp);
+	telemetry_update((uint32_t)begin_stamp, (uint32_t)current_stamp);
+#endif
+#if CONFIG_KCPS_GOVERNOR
+	core_kcps_account(cpu_get_id(), current_stamp - begin_stamp, current_stamp);
 #endif
 }
 
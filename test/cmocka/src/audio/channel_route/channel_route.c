@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/channel_route.h>
+#include <sof/common.h>
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define TEST_FRAMES	4
+
+/* Q6.10 gains */
+#define GAIN_HALF	(CHROUTE_UNITY_GAIN / 2)
+#define GAIN_DOUBLE	(CHROUTE_UNITY_GAIN * 2)
+#define GAIN_INVERT	(-(int)CHROUTE_UNITY_GAIN)
+
+static void stream_setup(struct audio_stream *stream, void *data, uint32_t size,
+			 enum sof_ipc_frame frame_fmt, uint16_t channels)
+{
+	audio_stream_init(stream, data, size);
+	audio_stream_set_frm_fmt(stream, frame_fmt);
+	audio_stream_set_valid_fmt(stream, frame_fmt);
+	audio_stream_set_channels(stream, channels);
+}
+
+static void test_chroute_copy_identity(void **state)
+{
+	int32_t in[TEST_FRAMES * 2] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	int32_t out[TEST_FRAMES * 2] = { 0 };
+	const struct chroute_elem elems[] = {
+		{ .stream = 0, .in_ch = 0, .out_ch = 0 },
+		{ .stream = 0, .in_ch = 1, .out_ch = 1 },
+	};
+	struct chroute_plan plan = { 0 };
+	struct audio_stream source, sink;
+	const struct audio_stream *sources[] = { &source };
+	int i;
+
+	(void)state;
+
+	stream_setup(&source, in, sizeof(in), SOF_IPC_FRAME_S32_LE, 2);
+	stream_setup(&sink, out, sizeof(out), SOF_IPC_FRAME_S32_LE, 2);
+
+	/* write position in the middle of the sink buffer makes the copy wrap */
+	audio_stream_produce(&sink, sizeof(out) / 2);
+
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_COPY,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	assert_int_equal(plan.num_ops, 2);
+	chroute_process(&plan, &sink, sources, TEST_FRAMES);
+
+	for (i = 0; i < TEST_FRAMES * 2; i++)
+		assert_int_equal(out[(i + TEST_FRAMES) % (TEST_FRAMES * 2)], in[i]);
+}
+
+static void test_chroute_copy_swap_s16(void **state)
+{
+	int16_t in[TEST_FRAMES * 2] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	int16_t out[TEST_FRAMES * 3];
+	const struct chroute_elem elems[] = {
+		{ .stream = 0, .in_ch = 1, .out_ch = 0 },
+		{ .stream = 0, .in_ch = 0, .out_ch = 1 },
+		/* does not fit the source layout, dropped */
+		{ .stream = 0, .in_ch = 2, .out_ch = 2 },
+	};
+	struct chroute_plan plan = { 0 };
+	struct audio_stream source, sink;
+	const struct audio_stream *sources[] = { &source };
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(out); i++)
+		out[i] = -1;
+
+	stream_setup(&source, in, sizeof(in), SOF_IPC_FRAME_S16_LE, 2);
+	stream_setup(&sink, out, sizeof(out), SOF_IPC_FRAME_S16_LE, 3);
+
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_COPY,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	assert_int_equal(plan.num_ops, 2);
+	chroute_process(&plan, &sink, sources, TEST_FRAMES);
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		assert_int_equal(out[i * 3], in[i * 2 + 1]);
+		assert_int_equal(out[i * 3 + 1], in[i * 2]);
+		/* sink channels that are not routed are not written */
+		assert_int_equal(out[i * 3 + 2], -1);
+	}
+}
+
+static void test_chroute_copy_silence(void **state)
+{
+	int32_t in[TEST_FRAMES] = { 1, 2, 3, 4 };
+	int32_t out[TEST_FRAMES * 2];
+	const struct chroute_elem elems[] = {
+		{ .stream = 0, .in_ch = 0, .out_ch = 0, .gain = CHROUTE_UNITY_GAIN },
+		{ .stream = 0, .in_ch = 0, .out_ch = 1, .gain = 0 },
+	};
+	struct chroute_plan plan = { 0 };
+	struct audio_stream source, sink;
+	const struct audio_stream *sources[] = { &source };
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(out); i++)
+		out[i] = -1;
+
+	stream_setup(&source, in, sizeof(in), SOF_IPC_FRAME_S32_LE, 1);
+	stream_setup(&sink, out, sizeof(out), SOF_IPC_FRAME_S32_LE, 2);
+
+	/* unity gains and silenced channels still run as a copy */
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	assert_int_equal(plan.num_ops, 2);
+	assert_int_equal(plan.op[1].num_taps, 0);
+	chroute_process(&plan, &sink, sources, TEST_FRAMES);
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		assert_int_equal(out[i * 2], in[i]);
+		assert_int_equal(out[i * 2 + 1], 0);
+	}
+}
+
+static void test_chroute_mix_two_streams(void **state)
+{
+	int32_t in0[TEST_FRAMES] = { 1000, -1000, 3, 0x100000 };
+	int32_t in1[TEST_FRAMES * 2] = { 100, 1, -100, 1, 2, 1, 0x100000, 1 };
+	int32_t out[TEST_FRAMES] = { 0 };
+	const struct chroute_elem elems[] = {
+		{ .stream = 0, .in_ch = 0, .out_ch = 0, .gain = GAIN_HALF },
+		{ .stream = 1, .in_ch = 0, .out_ch = 0, .gain = GAIN_DOUBLE },
+	};
+	const int32_t ref[TEST_FRAMES] = { 700, -700, 6, 0x280000 };
+	struct chroute_plan plan = { 0 };
+	struct audio_stream source0, source1, sink;
+	const struct audio_stream *sources[] = { &source0, &source1 };
+	int i;
+
+	(void)state;
+
+	stream_setup(&source0, in0, sizeof(in0), SOF_IPC_FRAME_S32_LE, 1);
+	stream_setup(&source1, in1, sizeof(in1), SOF_IPC_FRAME_S32_LE, 2);
+	stream_setup(&sink, out, sizeof(out), SOF_IPC_FRAME_S32_LE, 1);
+
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	assert_int_equal(plan.num_ops, 1);
+	assert_int_equal(plan.op[0].num_taps, 2);
+	chroute_process(&plan, &sink, sources, TEST_FRAMES);
+
+	/* 3 / 2 + 2 * 2 rounds to 6 */
+	for (i = 0; i < TEST_FRAMES; i++)
+		assert_int_equal(out[i], ref[i]);
+}
+
+static void test_chroute_mix_saturation(void **state)
+{
+	int16_t in16[2] = { INT16_MAX, INT16_MIN };
+	int16_t out16[2];
+	int32_t in24[2] = { 0x7fffff, -0x800000 };
+	int32_t out24[2];
+	int32_t in32[2] = { INT32_MAX, INT32_MIN };
+	int32_t out32[2];
+	const struct chroute_elem elems[] = {
+		{ .stream = 0, .in_ch = 0, .out_ch = 0, .gain = GAIN_DOUBLE },
+	};
+	struct chroute_plan plan = { 0 };
+	struct audio_stream source, sink;
+	const struct audio_stream *sources[] = { &source };
+
+	(void)state;
+
+	stream_setup(&source, in16, sizeof(in16), SOF_IPC_FRAME_S16_LE, 1);
+	stream_setup(&sink, out16, sizeof(out16), SOF_IPC_FRAME_S16_LE, 1);
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	chroute_process(&plan, &sink, sources, 2);
+	assert_int_equal(out16[0], INT16_MAX);
+	assert_int_equal(out16[1], INT16_MIN);
+
+	/* new frame format compiles the plan again */
+	stream_setup(&source, in24, sizeof(in24), SOF_IPC_FRAME_S24_4LE, 1);
+	stream_setup(&sink, out24, sizeof(out24), SOF_IPC_FRAME_S24_4LE, 1);
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	chroute_process(&plan, &sink, sources, 2);
+	assert_int_equal(out24[0], 0x7fffff);
+	assert_int_equal(out24[1], -0x800000);
+
+	stream_setup(&source, in32, sizeof(in32), SOF_IPC_FRAME_S32_LE, 1);
+	stream_setup(&sink, out32, sizeof(out32), SOF_IPC_FRAME_S32_LE, 1);
+	assert_int_equal(chroute_plan_update(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					     &sink, sources, ARRAY_SIZE(sources)), 0);
+	chroute_process(&plan, &sink, sources, 2);
+	assert_int_equal(out32[0], INT32_MAX);
+	assert_int_equal(out32[1], INT32_MIN);
+}
+
+static void test_chroute_compile_frames(void **state)
+{
+	const uint8_t source_channels[CHROUTE_MAX_STREAMS] = { 2 };
+	int32_t in[TEST_FRAMES * 2] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	int32_t out[TEST_FRAMES * 3] = { 0 };
+	const void *src[CHROUTE_MAX_STREAMS] = { in };
+	const struct chroute_elem elems[] = {
+		{ .stream = 0, .in_ch = 0, .out_ch = 0, .gain = CHROUTE_UNITY_GAIN },
+		{ .stream = 0, .in_ch = 1, .out_ch = 0, .gain = CHROUTE_UNITY_GAIN },
+		{ .stream = 0, .in_ch = 1, .out_ch = 2, .gain = GAIN_INVERT },
+	};
+	struct chroute_plan plan = { 0 };
+	int i;
+
+	(void)state;
+
+	assert_int_equal(chroute_plan_compile(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					      SOF_IPC_FRAME_S32_LE, 3, source_channels), 0);
+	chroute_process_frames(&plan, out, src, TEST_FRAMES);
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		assert_int_equal(out[i * 3], in[i * 2] + in[i * 2 + 1]);
+		/* sink channel 1 is not routed */
+		assert_int_equal(out[i * 3 + 1], 0);
+		assert_int_equal(out[i * 3 + 2], -in[i * 2 + 1]);
+	}
+
+	/* no routing function for the frame format */
+	assert_int_equal(chroute_plan_compile(&plan, elems, ARRAY_SIZE(elems), CHROUTE_MODE_MIX,
+					      SOF_IPC_FRAME_S24_3LE, 3, source_channels),
+			 -EINVAL);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chroute_copy_identity),
+		cmocka_unit_test(test_chroute_copy_swap_s16),
+		cmocka_unit_test(test_chroute_copy_silence),
+		cmocka_unit_test(test_chroute_mix_two_streams),
+		cmocka_unit_test(test_chroute_mix_saturation),
+		cmocka_unit_test(test_chroute_compile_frames),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "mixin_mixout/mixin_mixout.h"
+
+#define GAIN_HALF	(IPC4_MIXIN_UNITY_GAIN / 2)
+#define INT24_MAX	0x7fffff
+#define INT24_MIN	(-0x800000)
+
+/* 20 ms ramp at 48 kHz */
+#define RAMP_CHUNKS	(48000 * 20 / (1000 * MIXIN_GAIN_RAMP_CHUNK_FRAMES))
+#define RAMP_FRAMES	(RAMP_CHUNKS * MIXIN_GAIN_RAMP_CHUNK_FRAMES)
+#define RAMP_IN		10000
+
+static void cir_buf_setup(struct cir_buf_ptr *cb, void *buf, size_t size, size_t offset)
+{
+	cb->buf_start = buf;
+	cb->buf_end = (uint8_t *)buf + size;
+	cb->ptr = (uint8_t *)buf + offset;
+}
+
+static void test_mix_n_s16(void **state)
+{
+	int16_t in0[6] = { 100, -200, 10000, -30000, 1, 2 };
+	int16_t in1[6] = { 50, 60, 70, -80, 90, 100 };
+	const uint16_t gains[] = { IPC4_MIXIN_UNITY_GAIN, GAIN_HALF };
+	int16_t out[8] = { 0 };
+	struct cir_buf_ptr sources[2];
+	struct cir_buf_ptr sink;
+	mix_n_func mix_n;
+	int16_t expect;
+	int i;
+
+	(void)state;
+
+	mix_n = mixout_get_fused_function(SOF_IPC_FRAME_S16_LE);
+	assert_non_null(mix_n);
+
+	/* sink wraps after two samples, those are already mixed by other mixins */
+	out[6] = 30000;
+	out[7] = -1000;
+	cir_buf_setup(&sink, out, sizeof(out), 6 * sizeof(int16_t));
+	cir_buf_setup(&sources[0], in0, sizeof(in0), 0);
+	cir_buf_setup(&sources[1], in1, sizeof(in1), 0);
+
+	mix_n(&sink, 2, sources, gains, ARRAY_SIZE(sources), ARRAY_SIZE(in0));
+
+	assert_int_equal(out[6], 30000 + 100 + 25);
+	assert_int_equal(out[7], -1000 - 200 + 30);
+	for (i = 2; i < ARRAY_SIZE(in0); i++) {
+		expect = sat_int16(in0[i] + in1[i] / 2);
+		assert_int_equal(out[i - 2], expect);
+	}
+
+	/* both sources are advanced past the mixed samples */
+	assert_ptr_equal(cir_buf_wrap(sources[0].ptr, sources[0].buf_start, sources[0].buf_end),
+			 in0);
+	assert_ptr_equal(cir_buf_wrap(sources[1].ptr, sources[1].buf_start, sources[1].buf_end),
+			 in1);
+}
+
+static void test_mix_n_s16_saturation(void **state)
+{
+	int16_t in0[4] = { INT16_MAX, INT16_MIN, 20000, -20000 };
+	int16_t in1[4] = { 1, -1, 20000, -20000 };
+	const uint16_t gains[] = { IPC4_MIXIN_UNITY_GAIN, IPC4_MIXIN_UNITY_GAIN };
+	int16_t out[4];
+	struct cir_buf_ptr sources[2];
+	struct cir_buf_ptr sink;
+
+	(void)state;
+
+	cir_buf_setup(&sink, out, sizeof(out), 0);
+	cir_buf_setup(&sources[0], in0, sizeof(in0), 0);
+	cir_buf_setup(&sources[1], in1, sizeof(in1), 0);
+
+	mixout_get_fused_function(SOF_IPC_FRAME_S16_LE)(&sink, 0, sources, gains,
+							ARRAY_SIZE(sources), ARRAY_SIZE(out));
+
+	/* a single saturation of the whole sum */
+	assert_int_equal(out[0], INT16_MAX);
+	assert_int_equal(out[1], INT16_MIN);
+	assert_int_equal(out[2], INT16_MAX);
+	assert_int_equal(out[3], INT16_MIN);
+}
+
+static void test_mix_n_s24(void **state)
+{
+	/* upper byte of the container is not part of the sample */
+	int32_t in0[4] = { 0x00ffffff, 0x00800000, 0x7f400000, 0x100 };
+	int32_t in1[4] = { 0x00ffffff, 0x00800000, 0x00400000, 0x200 };
+	int32_t in2[4] = { 0x7fffff, 0x7fffff, 0x7fffff, 0x7fffff };
+	const uint16_t gains[] = { IPC4_MIXIN_UNITY_GAIN, IPC4_MIXIN_UNITY_GAIN, 0 };
+	int32_t out[4];
+	struct cir_buf_ptr sources[3];
+	struct cir_buf_ptr sink;
+
+	(void)state;
+
+	cir_buf_setup(&sink, out, sizeof(out), 0);
+	cir_buf_setup(&sources[0], in0, sizeof(in0), 0);
+	cir_buf_setup(&sources[1], in1, sizeof(in1), 0);
+	cir_buf_setup(&sources[2], in2, sizeof(in2), 0);
+
+	mixout_get_fused_function(SOF_IPC_FRAME_S24_4LE)(&sink, 0, sources, gains,
+							 ARRAY_SIZE(sources), ARRAY_SIZE(out));
+
+	/* the muted source does not contribute */
+	assert_int_equal(out[0], -2);
+	assert_int_equal(out[1], INT24_MIN);
+	assert_int_equal(out[2], INT24_MAX);
+	assert_int_equal(out[3], 0x300);
+}
+
+static void test_mix_n_s32(void **state)
+{
+	int32_t in0[4] = { 1000, -1000, INT32_MAX, 4096 };
+	int32_t in1[4] = { 2000, 2000, INT32_MAX, 4096 };
+	const uint16_t gains[] = { GAIN_HALF, IPC4_MIXIN_UNITY_GAIN };
+	int32_t out[4] = { 7, 7, 7, 7 };
+	struct cir_buf_ptr sources[2];
+	struct cir_buf_ptr sink;
+
+	(void)state;
+
+	/* the first source wraps in the middle of the mixed samples */
+	cir_buf_setup(&sink, out, sizeof(out), 0);
+	cir_buf_setup(&sources[0], in0, sizeof(in0), 2 * sizeof(int32_t));
+	cir_buf_setup(&sources[1], in1, sizeof(in1), 0);
+
+	mixout_get_fused_function(SOF_IPC_FRAME_S32_LE)(&sink, 1, sources, gains,
+							ARRAY_SIZE(sources), ARRAY_SIZE(out));
+
+	/* sink data is an input only for the mixed samples */
+	assert_int_equal(out[0], 7 + INT32_MAX / 2 + 2000);
+	assert_int_equal(out[1], 2048 + 2000);
+	assert_int_equal(out[2], INT32_MAX);
+	assert_int_equal(out[3], -500 + 4096);
+}
+
+/* Mix mono frames as mixin does, in chunks with a constant gain, the sink is a copy of
+ * the source. Returns the number of frames mixed before the gain reaches its target.
+ */
+static int mix_ramped(struct mixin_sink_config *sink_config, int16_t *out, int frame_count)
+{
+	int16_t in[RAMP_FRAMES];
+	struct cir_buf_ptr source;
+	struct cir_buf_ptr sink;
+	mix_func mix, gain_mix;
+	int ramp_end = -1;
+	int frames;
+	int done;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(in); i++)
+		in[i] = RAMP_IN;
+
+	assert_true(mixin_get_processing_functions(SOF_IPC_FRAME_S16_LE, &mix, &gain_mix));
+	cir_buf_setup(&sink, out, frame_count * sizeof(int16_t), 0);
+
+	for (done = 0; done < frame_count; done += frames) {
+		if (ramp_end < 0 && sink_config->gain == sink_config->target_gain)
+			ramp_end = done;
+
+		frames = MIN(frame_count - done, mixin_gain_frames(sink_config));
+		frames = MIN(frames, ARRAY_SIZE(in));
+		cir_buf_setup(&source, in, sizeof(in), 0);
+		(sink_config->gain == IPC4_MIXIN_UNITY_GAIN ? mix : gain_mix)
+			(&sink, done, done, &source, frames, sink_config->gain);
+		mixin_gain_advance(sink_config, frames);
+	}
+
+	return ramp_end;
+}
+
+static void test_gain_ramp_down_and_up(void **state)
+{
+	struct mixin_sink_config sink_config = {
+		.gain = IPC4_MIXIN_UNITY_GAIN,
+		.target_gain = IPC4_MIXIN_UNITY_GAIN,
+	};
+	int16_t out[RAMP_FRAMES * 2];
+	int ramp_end;
+	int i;
+
+	(void)state;
+
+	/* soft mute */
+	mixin_gain_ramp_start(&sink_config, 0, RAMP_CHUNKS);
+	ramp_end = mix_ramped(&sink_config, out, ARRAY_SIZE(out));
+
+	/* the gain reaches its target within the ramp and never moves back */
+	assert_true(ramp_end > 0 && ramp_end <= RAMP_FRAMES);
+	assert_int_equal(sink_config.gain, 0);
+	assert_int_equal(out[0], RAMP_IN);
+	for (i = 1; i < ramp_end; i++)
+		assert_true(out[i] <= out[i - 1]);
+
+	/* the steps are small, no step larger than the gain step of a chunk */
+	for (i = 1; i < ramp_end; i++)
+		assert_true(out[i - 1] - out[i] <=
+			    RAMP_IN * sink_config.ramp_step / IPC4_MIXIN_UNITY_GAIN + 1);
+
+	/* unmute ramps back to unity */
+	mixin_gain_ramp_start(&sink_config, IPC4_MIXIN_UNITY_GAIN, RAMP_CHUNKS);
+	ramp_end = mix_ramped(&sink_config, out, ARRAY_SIZE(out));
+
+	assert_true(ramp_end > 0 && ramp_end <= RAMP_FRAMES);
+	assert_int_equal(sink_config.gain, IPC4_MIXIN_UNITY_GAIN);
+	assert_int_equal(out[0], 0);
+	for (i = 1; i < ramp_end; i++)
+		assert_true(out[i] >= out[i - 1]);
+	for (i = ramp_end; i < ARRAY_SIZE(out); i++)
+		assert_int_equal(out[i], RAMP_IN);
+}
+
+static void test_gain_mute_silent(void **state)
+{
+	struct mixin_sink_config sink_config = {
+		.gain = IPC4_MIXIN_UNITY_GAIN,
+		.target_gain = IPC4_MIXIN_UNITY_GAIN,
+	};
+	int16_t out[RAMP_FRAMES * 2];
+	int ramp_end;
+	int i;
+
+	(void)state;
+
+	/* without a ramp the gain is applied at once */
+	mixin_gain_ramp_start(&sink_config, 0, 0);
+	assert_int_equal(sink_config.gain, 0);
+
+	for (i = 0; i < ARRAY_SIZE(out); i++)
+		out[i] = -1;
+
+	ramp_end = mix_ramped(&sink_config, out, ARRAY_SIZE(out));
+
+	assert_int_equal(ramp_end, 0);
+	for (i = 0; i < ARRAY_SIZE(out); i++)
+		assert_int_equal(out[i], 0);
+
+	/* after a ramp to mute the rest of the output is silent */
+	sink_config.gain = IPC4_MIXIN_UNITY_GAIN;
+	sink_config.target_gain = IPC4_MIXIN_UNITY_GAIN;
+	mixin_gain_ramp_start(&sink_config, 0, RAMP_CHUNKS);
+	ramp_end = mix_ramped(&sink_config, out, ARRAY_SIZE(out));
+
+	for (i = ramp_end; i < ARRAY_SIZE(out); i++)
+		assert_int_equal(out[i], 0);
+}
+
+static void test_mix_n_no_function(void **state)
+{
+	(void)state;
+
+	assert_null(mixout_get_fused_function(SOF_IPC_FRAME_S24_3LE));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_mix_n_s16),
+		cmocka_unit_test(test_mix_n_s16_saturation),
+		cmocka_unit_test(test_mix_n_s24),
+		cmocka_unit_test(test_mix_n_s32),
+		cmocka_unit_test(test_mix_n_no_function),
+		cmocka_unit_test(test_gain_ramp_down_and_up),
+		cmocka_unit_test(test_gain_mute_silent),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -85,6 +85,55 @@ static void matrix_mult_16_test(const int16_t *a_ref, const int16_t *b_ref, cons
 	assert_true(delta_max < MATRIX_MULT_16_MAX_ERROR_ABS);
 }
 
+/* Multiply with a sparse version of matrix a where every third value is zero,
+ * the result must match exactly the dense multiply of the same data.
+ */
+static void matrix_mult_sparse_16_test(const int16_t *a_ref, const int16_t *b_ref,
+				       int a_rows, int a_columns, int b_rows, int b_columns,
+				       int c_rows, int c_columns, int a_frac, int b_frac,
+				       int c_frac)
+{
+	struct mat_sparse_16b *a_sparse;
+	struct mat_matrix_16b *a_matrix;
+	struct mat_matrix_16b *b_matrix;
+	struct mat_matrix_16b *c_matrix;
+	struct mat_matrix_16b *c_sparse;
+	int num_values = 0;
+	int i;
+
+	a_matrix = mat_matrix_alloc_16b(a_rows, a_columns, a_frac);
+	b_matrix = mat_matrix_alloc_16b(b_rows, b_columns, b_frac);
+	c_matrix = mat_matrix_alloc_16b(c_rows, c_columns, c_frac);
+	c_sparse = mat_matrix_alloc_16b(c_rows, c_columns, c_frac);
+	if (!a_matrix || !b_matrix || !c_matrix || !c_sparse)
+		exit(EXIT_FAILURE);
+
+	mat_copy_from_linear_16b(a_matrix, a_ref);
+	mat_copy_from_linear_16b(b_matrix, b_ref);
+	for (i = 0; i < a_rows * a_columns; i++) {
+		if (i % 3 == 0)
+			a_matrix->data[i] = 0;
+		else
+			num_values++;
+	}
+
+	a_sparse = mat_sparse_alloc_from_16b(a_matrix);
+	if (!a_sparse)
+		exit(EXIT_FAILURE);
+
+	assert_int_equal(a_sparse->num_values, num_values);
+	assert_int_equal(mat_multiply(a_matrix, b_matrix, c_matrix), 0);
+	assert_int_equal(mat_multiply_sparse(a_sparse, b_matrix, c_sparse), 0);
+	for (i = 0; i < c_rows * c_columns; i++)
+		assert_int_equal(c_sparse->data[i], c_matrix->data[i]);
+
+	free(a_sparse);
+	free(a_matrix);
+	free(b_matrix);
+	free(c_matrix);
+	free(c_sparse);
+}
+
 static void test_matrix_mult_16_test1(void **state)
 {
 	(void)state;
@@ -161,6 +210,57 @@ static void test_matrix_mult_16_test4(void **state)
 			    MATRIX_MULT_16_TEST4_C_QXY_Y);
 }
 
+static void test_matrix_mult_sparse_16_test1(void **state)
+{
+	(void)state;
+
+	matrix_mult_sparse_16_test(matrix_mult_16_test1_a,
+				   matrix_mult_16_test1_b,
+				   MATRIX_MULT_16_TEST1_A_ROWS,
+				   MATRIX_MULT_16_TEST1_A_COLUMNS,
+				   MATRIX_MULT_16_TEST1_B_ROWS,
+				   MATRIX_MULT_16_TEST1_B_COLUMNS,
+				   MATRIX_MULT_16_TEST1_C_ROWS,
+				   MATRIX_MULT_16_TEST1_C_COLUMNS,
+				   MATRIX_MULT_16_TEST1_A_QXY_Y,
+				   MATRIX_MULT_16_TEST1_B_QXY_Y,
+				   MATRIX_MULT_16_TEST1_C_QXY_Y);
+}
+
+static void test_matrix_mult_sparse_16_test2(void **state)
+{
+	(void)state;
+
+	matrix_mult_sparse_16_test(matrix_mult_16_test2_a,
+				   matrix_mult_16_test2_b,
+				   MATRIX_MULT_16_TEST2_A_ROWS,
+				   MATRIX_MULT_16_TEST2_A_COLUMNS,
+				   MATRIX_MULT_16_TEST2_B_ROWS,
+				   MATRIX_MULT_16_TEST2_B_COLUMNS,
+				   MATRIX_MULT_16_TEST2_C_ROWS,
+				   MATRIX_MULT_16_TEST2_C_COLUMNS,
+				   MATRIX_MULT_16_TEST2_A_QXY_Y,
+				   MATRIX_MULT_16_TEST2_B_QXY_Y,
+				   MATRIX_MULT_16_TEST2_C_QXY_Y);
+}
+
+static void test_matrix_mult_sparse_16_test4(void **state)
+{
+	(void)state;
+
+	matrix_mult_sparse_16_test(matrix_mult_16_test4_a,
+				   matrix_mult_16_test4_b,
+				   MATRIX_MULT_16_TEST4_A_ROWS,
+				   MATRIX_MULT_16_TEST4_A_COLUMNS,
+				   MATRIX_MULT_16_TEST4_B_ROWS,
+				   MATRIX_MULT_16_TEST4_B_COLUMNS,
+				   MATRIX_MULT_16_TEST4_C_ROWS,
+				   MATRIX_MULT_16_TEST4_C_COLUMNS,
+				   MATRIX_MULT_16_TEST4_A_QXY_Y,
+				   MATRIX_MULT_16_TEST4_B_QXY_Y,
+				   MATRIX_MULT_16_TEST4_C_QXY_Y);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -168,6 +268,9 @@ int main(void)
 		cmocka_unit_test(test_matrix_mult_16_test2),
 		cmocka_unit_test(test_matrix_mult_16_test3),
 		cmocka_unit_test(test_matrix_mult_16_test4),
+		cmocka_unit_test(test_matrix_mult_sparse_16_test1),
+		cmocka_unit_test(test_matrix_mult_sparse_16_test2),
+		cmocka_unit_test(test_matrix_mult_sparse_16_test4),
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
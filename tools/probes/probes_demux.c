@@ -18,6 +18,7 @@
 
 #include <ipc/probe_dma_frame.h>
 
+#include "probes_demux.h"
 #include "wave.h"
 
 #define APP_NAME "sof-probes"
@@ -32,6 +33,7 @@ struct wave_files {
 	uint32_t buffer_id;
 	uint32_t fmt;
 	uint32_t size;
+	uint32_t part;		/* Number of files written before for the buffer */
 	struct wave header;
 };
 
@@ -52,6 +54,11 @@ struct dma_frame_parser {
 	int len;				/* Data buffer fill level */
 	uint8_t data[DATA_READ_LIMIT];
 	struct wave_files files[FILES_LIMIT];
+	uint8_t *decoded;			/* Decoded compressed packet data */
+	size_t decoded_size;
+	parser_write_t write;			/* Data writer, fwrite() if NULL */
+	parser_flush_t flush;			/* Completes writes before file is closed */
+	void *write_ctx;
 };
 
 static uint32_t sample_rate[] = {
@@ -86,9 +93,11 @@ bool is_audio_format(uint32_t format)
 	return (format & PROBE_MASK_FMT_TYPE) != 0 && (format & PROBE_MASK_AUDIO_FMT) == 0;
 }
 
-int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
+int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format, uint32_t part)
 {
 	bool audio = is_audio_format(format);
+	uint32_t decimation = ((format & PROBE_MASK_DECIMATION) >> PROBE_SHIFT_DECIMATION) + 1;
+	uint32_t rate = sample_rate[(format & PROBE_MASK_SAMPLE_RATE) >> PROBE_SHIFT_SAMPLE_RATE];
 	char path[FILE_PATH_LIMIT];
 	int i;
 
@@ -98,7 +107,10 @@ int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
 		exit(0);
 	}
 
-	sprintf(path, "buffer_%d.%s", buffer_id, audio ? "wav" : "bin");
+	if (part)
+		sprintf(path, "buffer_%d_%u.%s", buffer_id, part, audio ? "wav" : "bin");
+	else
+		sprintf(path, "buffer_%d.%s", buffer_id, audio ? "wav" : "bin");
 
 	fprintf(stderr, "%s:\t Creating file %s\n", APP_NAME, path);
 
@@ -115,6 +127,8 @@ int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
 
 	p->files[i].buffer_id = buffer_id;
 	p->files[i].fmt = format;
+	p->files[i].size = 0;
+	p->files[i].part = part;
 
 	if (!audio)
 		return i;
@@ -125,7 +139,10 @@ int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
 	p->files[i].header.fmt.subchunk_size = 16;
 	p->files[i].header.fmt.audio_format = 1;
 	p->files[i].header.fmt.num_channels = ((format & PROBE_MASK_NB_CHANNELS) >> PROBE_SHIFT_NB_CHANNELS) + 1;
-	p->files[i].header.fmt.sample_rate = sample_rate[(format & PROBE_MASK_SAMPLE_RATE) >> PROBE_SHIFT_SAMPLE_RATE];
+	if (rate % decimation)
+		fprintf(stderr, "warning: rate %u of %s is not a multiple of decimation %u\n",
+			rate, path, decimation);
+	p->files[i].header.fmt.sample_rate = (rate + decimation / 2) / decimation;
 	p->files[i].header.fmt.bits_per_sample = (((format & PROBE_MASK_CONTAINER_SIZE) >> PROBE_SHIFT_CONTAINER_SIZE) + 1) * 8;
 	p->files[i].header.fmt.byte_rate = p->files[i].header.fmt.sample_rate *
 					p->files[i].header.fmt.num_channels *
@@ -139,32 +156,56 @@ int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
 	return i;
 }
 
-void finalize_wave_files(struct dma_frame_parser *p)
+/* fill the header at the beginning of the file and close it */
+/* check wave struct to understand the offsets */
+void finalize_wave_file(struct wave_files *file)
 {
-	struct wave_files *files = p->files;
-	uint32_t i, chunk_size;
+	uint32_t chunk_size;
 
-	/* fill the header at the beginning of each file */
-	/* and close all opened files */
-	/* check wave struct to understand the offsets */
-	for (i = 0; i < FILES_LIMIT; i++) {
-		if (!is_audio_format(files[i].fmt))
-			continue;
+	if (!is_audio_format(file->fmt) || !file->fd)
+		return;
 
-		if (files[i].fd) {
-			chunk_size = files[i].size + sizeof(struct wave) -
-				     offsetof(struct riff_chunk, format);
+	chunk_size = file->size + sizeof(struct wave) -
+		     offsetof(struct riff_chunk, format);
 
-			fseek(files[i].fd, sizeof(uint32_t), SEEK_SET);
-			fwrite(&chunk_size, sizeof(uint32_t), 1, files[i].fd);
-			fseek(files[i].fd, sizeof(struct wave) -
-			      offsetof(struct data_subchunk, subchunk_size),
-			      SEEK_SET);
-			fwrite(&files[i].size, sizeof(uint32_t), 1, files[i].fd);
+	fseek(file->fd, sizeof(uint32_t), SEEK_SET);
+	fwrite(&chunk_size, sizeof(uint32_t), 1, file->fd);
+	fseek(file->fd, sizeof(struct wave) -
+	      offsetof(struct data_subchunk, subchunk_size),
+	      SEEK_SET);
+	fwrite(&file->size, sizeof(uint32_t), 1, file->fd);
 
-			fclose(files[i].fd);
-		}
-	}
+	fclose(file->fd);
+	file->fd = NULL;
+}
+
+/* complete writes queued by the data writer before the header is finalized */
+static void close_wave_file(struct dma_frame_parser *p, struct wave_files *file)
+{
+	if (p->flush)
+		p->flush(p->write_ctx, file->fd);
+
+	finalize_wave_file(file);
+}
+
+void finalize_wave_files(struct dma_frame_parser *p)
+{
+	uint32_t i;
+
+	for (i = 0; i < FILES_LIMIT; i++)
+		finalize_wave_file(&p->files[i]);
+}
+
+/*
+ * Channel count and decimation of a buffer change when the host configures
+ * data reduction of its probe point. The wave header describes a single
+ * format, so the data of the new format goes to a new file. Compression is
+ * chosen per packet and does not change the decoded format.
+ */
+bool is_format_change(uint32_t fmt, uint32_t format)
+{
+	return is_audio_format(format) &&
+	       (fmt & ~PROBE_MASK_COMPRESSION) != (format & ~PROBE_MASK_COMPRESSION);
 }
 
 int validate_data_packet(struct probe_data_packet *packet)
@@ -190,6 +231,81 @@ int validate_data_packet(struct probe_data_packet *packet)
 	return 0;
 }
 
+/* decode delta coded samples described in probe_dma_frame.h */
+int decode_packet(struct dma_frame_parser *p, uint8_t **data, uint32_t *size)
+{
+	struct probe_data_packet *packet = p->packet;
+	uint32_t format = packet->format;
+	uint32_t channels = ((format & PROBE_MASK_NB_CHANNELS) >> PROBE_SHIFT_NB_CHANNELS) + 1;
+	uint32_t container;
+	uint8_t *in = packet->data;
+	uint8_t *end = packet->data + packet->data_size_bytes;
+	size_t max_size;
+	uint32_t samples = 0;
+	uint32_t value;
+	uint32_t prev;
+	uint8_t *temp;
+	int shift;
+
+	container = ((format & PROBE_MASK_CONTAINER_SIZE) >> PROBE_SHIFT_CONTAINER_SIZE) + 1;
+
+	if (!(format & PROBE_MASK_COMPRESSION)) {
+		*data = packet->data;
+		*size = packet->data_size_bytes;
+		return 0;
+	}
+
+	if (container != sizeof(uint16_t) && container != sizeof(uint32_t)) {
+		fprintf(stderr, "error: unsupported compressed container size %u\n", container);
+		return -EINVAL;
+	}
+
+	/* every sample takes at least one byte */
+	max_size = (size_t)packet->data_size_bytes * container;
+	if (max_size > p->decoded_size) {
+		temp = realloc(p->decoded, max_size);
+		if (!temp)
+			return -ENOMEM;
+
+		p->decoded = temp;
+		p->decoded_size = max_size;
+	}
+
+	while (in < end) {
+		value = 0;
+		shift = 0;
+		do {
+			if (in == end || shift > 28) {
+				fprintf(stderr, "error: corrupted compressed packet\n");
+				return -EINVAL;
+			}
+			value |= (uint32_t)(*in & 0x7f) << shift;
+			shift += 7;
+		} while (*in++ & 0x80);
+
+		/* zigzag to signed difference to previous sample of the channel */
+		value = (value >> 1) ^ -(value & 1);
+
+		if (container == sizeof(uint16_t)) {
+			uint16_t *out = (uint16_t *)p->decoded;
+
+			prev = samples < channels ? 0 : out[samples - channels];
+			out[samples] = prev + value;
+		} else {
+			uint32_t *out = (uint32_t *)p->decoded;
+
+			prev = samples < channels ? 0 : out[samples - channels];
+			out[samples] = prev + value;
+		}
+		samples++;
+	}
+
+	*data = p->decoded;
+	*size = samples * container;
+
+	return 0;
+}
+
 int process_sync(struct dma_frame_parser *p)
 {
 	struct probe_data_packet *temp_packet;
@@ -238,6 +354,7 @@ struct dma_frame_parser *parser_init(void)
 
 void parser_free(struct dma_frame_parser *p)
 {
+	free(p->decoded);
 	free(p->packet);
 	free(p);
 }
@@ -247,6 +364,14 @@ void parser_log_to_stdout(struct dma_frame_parser *p)
 	p->log_to_stdout = true;
 }
 
+void parser_set_writer(struct dma_frame_parser *p, parser_write_t write,
+		       parser_flush_t flush, void *ctx)
+{
+	p->write = write;
+	p->flush = flush;
+	p->write_ctx = ctx;
+}
+
 void parser_fetch_free_buffer(struct dma_frame_parser *p, uint8_t **d, size_t *len)
 {
 	*d = &p->data[p->start];
@@ -295,10 +420,20 @@ int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 				if (validate_data_packet(p->packet) == 0) {
 					int file = get_buffer_file(p->files,
 								   p->packet->buffer_id);
-
-					if (file < 0)
+					uint8_t *data;
+					uint32_t size;
+					uint32_t part;
+
+					if (file >= 0 && is_format_change(p->files[file].fmt,
+									  p->packet->format)) {
+						part = p->files[file].part + 1;
+						close_wave_file(p, &p->files[file]);
+						file = init_wave(p, p->packet->buffer_id,
+								 p->packet->format, part);
+					} else if (file < 0) {
 						file = init_wave(p, p->packet->buffer_id,
-								 p->packet->format);
+								 p->packet->format, 0);
+					}
 
 					if (file < 0) {
 						fprintf(stderr,
@@ -307,10 +442,17 @@ int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 						return -EIO;
 					}
 
-					fwrite(p->packet->data, 1,
-					       p->packet->data_size_bytes,
-					       p->files[file].fd);
-					p->files[file].size += p->packet->data_size_bytes;
+					if (decode_packet(p, &data, &size) < 0) {
+						p->state = READY;
+						break;
+					}
+
+					if (p->write)
+						p->write(p->write_ctx, p->packet->buffer_id,
+							 p->files[file].fd, data, size);
+					else
+						fwrite(data, 1, size, p->files[file].fd);
+					p->files[file].size += size;
 					}
 				p->state = READY;
 				break;
@@ -8,18 +8,29 @@
 #ifndef _PROBES_DEMUX_H_
 #define _PROBES_DEMUX_H_
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 struct dma_frame_parser;
 
+/* Writes audio data of a parsed packet to the file of its buffer */
+typedef void (*parser_write_t)(void *ctx, uint32_t buffer_id, FILE *fd,
+			       const uint8_t *data, size_t size);
+
+/* Completes all writes to a file, called before the parser finalizes and closes it */
+typedef void (*parser_flush_t)(void *ctx, FILE *fd);
+
 struct dma_frame_parser *parser_init(void);
 
 void parser_log_to_stdout(struct dma_frame_parser *p);
 
 void parser_free(struct dma_frame_parser *p);
 
+void parser_set_writer(struct dma_frame_parser *p, parser_write_t write,
+		       parser_flush_t flush, void *ctx);
+
 void parser_fetch_free_buffer(struct dma_frame_parser *p, uint8_t **d, size_t *len);
 
 int parser_parse_data(struct dma_frame_parser *p, size_t d_len);
@@ -11,17 +11,28 @@
  *
  * Usage to parse data and create wave files: ./sof-probes -p data.bin
  *
+ * Usage to parse a live capture from a pipe with separate reader, parser
+ * and per buffer writer threads: ./sof-probes -s -p /path/to/fifo
+ *
+ * Usage to parse a live capture from a TCP socket: ./sof-probes -n host:port
+ *
  */
 
 #include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
 #include <unistd.h>
 
 #include "probes_demux.h"
+#include "probes_stream.h"
 
 #define APP_NAME "sof-probes"
 
@@ -29,6 +40,10 @@ static void usage(void)
 {
 	fprintf(stdout, "Usage %s <option(s)> <buffer_id/file>\n\n", APP_NAME);
 	fprintf(stdout, "%s:\t -p file\tParse extracted file\n\n", APP_NAME);
+	fprintf(stdout, "%s:\t -s \t\tStream mode, threaded parsing of pipe or stdin\n\n",
+		APP_NAME);
+	fprintf(stdout, "%s:\t -n host:port\tStream mode, parse data from TCP socket\n\n",
+		APP_NAME);
 	fprintf(stdout, "%s:\t -l \t\tLog to stdout\n\n", APP_NAME);
 	fprintf(stdout, "%s:\t -h \t\tHelp, usage info\n", APP_NAME);
 	exit(0);
@@ -72,17 +87,92 @@ void parse_data(const char *file_in, bool log_to_stdout)
 
 }
 
+static int connect_socket(char *address)
+{
+	struct addrinfo hints = {
+		.ai_family = AF_UNSPEC,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct addrinfo *res, *ai;
+	char *port = strrchr(address, ':');
+	int fd = -1;
+	int ret;
+
+	if (!port) {
+		fprintf(stderr, "error: socket address %s is not host:port\n", address);
+		return -EINVAL;
+	}
+	*port++ = '\0';
+
+	ret = getaddrinfo(address, port, &hints, &res);
+	if (ret) {
+		fprintf(stderr, "error: unable to resolve %s, %s\n", address, gai_strerror(ret));
+		return -EINVAL;
+	}
+
+	for (ai = res; ai; ai = ai->ai_next) {
+		fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (fd < 0)
+			continue;
+		if (!connect(fd, ai->ai_addr, ai->ai_addrlen))
+			break;
+		close(fd);
+		fd = -1;
+	}
+	freeaddrinfo(res);
+
+	if (fd < 0)
+		fprintf(stderr, "error: unable to connect to %s:%s, error %d\n",
+			address, port, errno);
+
+	return fd;
+}
+
+static void stream_data(const char *file_in, char *address, bool log_to_stdout)
+{
+	int fd_in;
+	int ret;
+
+	if (address)
+		fd_in = connect_socket(address);
+	else if (file_in)
+		fd_in = open(file_in, O_RDONLY);
+	else
+		fd_in = STDIN_FILENO;
+
+	if (fd_in < 0) {
+		fprintf(stderr, "error: unable to open input, error %d\n", errno);
+		exit(1);
+	}
+
+	ret = parse_stream(fd_in, log_to_stdout);
+	if (ret < 0)
+		fprintf(stderr, "error: stream parsing failed, error %d\n", ret);
+
+	if (fd_in != STDIN_FILENO)
+		close(fd_in);
+}
+
 int main(int argc, char *argv[])
 {
 	const char *fname = NULL;
+	char *address = NULL;
 	bool log_to_stdout = false;
+	bool stream = false;
 	int opt;
 
-	while ((opt = getopt(argc, argv, "lhp:")) != -1) {
+	while ((opt = getopt(argc, argv, "lhsp:n:")) != -1) {
 		switch (opt) {
 		case 'p':
 			fname = optarg;
 			break;
+		case 's':
+			stream = true;
+			break;
+		case 'n':
+			address = optarg;
+			stream = true;
+			break;
 		case 'l':
 			log_to_stdout = true;
 			break;
@@ -92,7 +182,10 @@ int main(int argc, char *argv[])
 			return 0;
 		}
 	}
-	parse_data(fname, log_to_stdout);
+	if (stream)
+		stream_data(fname, address, log_to_stdout);
+	else
+		parse_data(fname, log_to_stdout);
 
 	return 0;
 }
@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+//
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "probes_demux.h"
+#include "probes_stream.h"
+
+#define INPUT_QUEUE_SIZE	(16 * 1024 * 1024)	/**< Read data not parsed yet */
+#define WRITER_QUEUE_SIZE	(4 * 1024 * 1024)	/**< Parsed data not written yet */
+#define READ_CHUNK_SIZE		(64 * 1024)		/**< Size of single read() */
+#define WRITE_CHUNK_SIZE	(256 * 1024)		/**< Size of single fwrite() */
+#define WRITERS_LIMIT		32			/**< Same as demux files limit */
+
+/* Blocking single producer, single consumer byte queue */
+struct byte_queue {
+	uint8_t *data;
+	size_t size;
+	size_t head;		/* Read offset */
+	size_t fill;		/* Bytes queued */
+	size_t max_fill;	/* Fill level high watermark */
+	bool closed;		/* No more data will be queued */
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+};
+
+/* Writes data of one file, a buffer gets a new file when its format changes */
+struct stream_writer {
+	bool active;
+	uint32_t buffer_id;
+	FILE *fd;
+	struct byte_queue queue;
+	pthread_t thread;
+};
+
+struct probe_stream {
+	struct dma_frame_parser *parser;
+	struct byte_queue input;
+	pthread_t parser_thread;
+	struct stream_writer writers[WRITERS_LIMIT];
+	int error;
+};
+
+static int queue_init(struct byte_queue *q, size_t size)
+{
+	memset(q, 0, sizeof(*q));
+	q->data = malloc(size);
+	if (!q->data)
+		return -ENOMEM;
+
+	q->size = size;
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->cond, NULL);
+
+	return 0;
+}
+
+static void queue_free(struct byte_queue *q)
+{
+	pthread_cond_destroy(&q->cond);
+	pthread_mutex_destroy(&q->lock);
+	free(q->data);
+}
+
+static void queue_close(struct byte_queue *q)
+{
+	pthread_mutex_lock(&q->lock);
+	q->closed = true;
+	pthread_cond_broadcast(&q->cond);
+	pthread_mutex_unlock(&q->lock);
+}
+
+/* Queue all data, wait for the consumer when the queue is full */
+static bool queue_write(struct byte_queue *q, const uint8_t *data, size_t len)
+{
+	size_t tail;
+	size_t n;
+
+	pthread_mutex_lock(&q->lock);
+	while (len && !q->closed) {
+		while (q->fill == q->size && !q->closed)
+			pthread_cond_wait(&q->cond, &q->lock);
+		if (q->closed)
+			break;
+
+		/* copy without the lock, consumer only reads queued bytes */
+		tail = (q->head + q->fill) % q->size;
+		n = q->size - q->fill;
+		if (n > q->size - tail)
+			n = q->size - tail;
+		if (n > len)
+			n = len;
+		pthread_mutex_unlock(&q->lock);
+
+		memmove(q->data + tail, data, n);
+		data += n;
+		len -= n;
+
+		pthread_mutex_lock(&q->lock);
+		q->fill += n;
+		if (q->fill > q->max_fill)
+			q->max_fill = q->fill;
+		pthread_cond_broadcast(&q->cond);
+	}
+	pthread_mutex_unlock(&q->lock);
+
+	return !len;
+}
+
+/* Dequeue up to len bytes, return 0 once the queue is closed and empty */
+static size_t queue_read(struct byte_queue *q, uint8_t *data, size_t len)
+{
+	size_t n;
+
+	pthread_mutex_lock(&q->lock);
+	while (!q->fill && !q->closed)
+		pthread_cond_wait(&q->cond, &q->lock);
+
+	n = q->fill;
+	if (n > q->size - q->head)
+		n = q->size - q->head;
+	if (n > len)
+		n = len;
+	pthread_mutex_unlock(&q->lock);
+
+	/* copy without the lock, producer only writes free bytes */
+	memmove(data, q->data + q->head, n);
+
+	pthread_mutex_lock(&q->lock);
+	q->head = (q->head + n) % q->size;
+	q->fill -= n;
+	pthread_cond_broadcast(&q->cond);
+	pthread_mutex_unlock(&q->lock);
+
+	return n;
+}
+
+static void *writer_thread(void *arg)
+{
+	struct stream_writer *w = arg;
+	uint8_t *chunk = malloc(WRITE_CHUNK_SIZE);
+	size_t len;
+
+	if (!chunk) {
+		fprintf(stderr, "error: writer allocation failed for buffer %u\n", w->buffer_id);
+		return NULL;
+	}
+
+	while ((len = queue_read(&w->queue, chunk, WRITE_CHUNK_SIZE)) > 0) {
+		if (fwrite(chunk, 1, len, w->fd) != len)
+			fprintf(stderr, "error: write failed for buffer %u, error %d\n",
+				w->buffer_id, errno);
+	}
+
+	fflush(w->fd);
+	free(chunk);
+
+	return NULL;
+}
+
+static struct stream_writer *get_writer(struct probe_stream *s, uint32_t buffer_id, FILE *fd)
+{
+	struct stream_writer *w = NULL;
+	int i;
+
+	for (i = 0; i < WRITERS_LIMIT; i++) {
+		if (s->writers[i].active && s->writers[i].fd == fd)
+			return &s->writers[i];
+		if (!s->writers[i].active && !w)
+			w = &s->writers[i];
+	}
+
+	if (!w)
+		return NULL;
+
+	w->buffer_id = buffer_id;
+	w->fd = fd;
+	if (queue_init(&w->queue, WRITER_QUEUE_SIZE) < 0)
+		return NULL;
+
+	if (pthread_create(&w->thread, NULL, writer_thread, w)) {
+		queue_free(&w->queue);
+		return NULL;
+	}
+
+	w->active = true;
+
+	return w;
+}
+
+/* Write all queued data and stop the writer */
+static void writer_stop(struct stream_writer *w)
+{
+	queue_close(&w->queue);
+	pthread_join(w->thread, NULL);
+	fprintf(stderr, "buffer %u queue high watermark %zu of %zu bytes\n",
+		w->buffer_id, w->queue.max_fill, w->queue.size);
+	queue_free(&w->queue);
+	w->active = false;
+}
+
+/* Called from parser thread for data of each valid packet */
+static void stream_write(void *ctx, uint32_t buffer_id, FILE *fd,
+			 const uint8_t *data, size_t size)
+{
+	struct probe_stream *s = ctx;
+	struct stream_writer *w = get_writer(s, buffer_id, fd);
+
+	if (!w) {
+		fprintf(stderr, "error: no writer for buffer %u, writing directly\n", buffer_id);
+		fwrite(data, 1, size, fd);
+		return;
+	}
+
+	queue_write(&w->queue, data, size);
+}
+
+/* Called from parser thread before it finalizes and closes a file */
+static void stream_flush(void *ctx, FILE *fd)
+{
+	struct probe_stream *s = ctx;
+	int i;
+
+	for (i = 0; i < WRITERS_LIMIT; i++)
+		if (s->writers[i].active && s->writers[i].fd == fd)
+			writer_stop(&s->writers[i]);
+}
+
+static void *parser_thread(void *arg)
+{
+	struct probe_stream *s = arg;
+	uint8_t *data;
+	size_t len;
+
+	for (;;) {
+		parser_fetch_free_buffer(s->parser, &data, &len);
+		len = queue_read(&s->input, data, len);
+		if (!len)
+			break;
+
+		s->error = parser_parse_data(s->parser, len);
+		if (s->error < 0)
+			break;
+	}
+
+	/* stop reader if parsing failed */
+	queue_close(&s->input);
+
+	return NULL;
+}
+
+int parse_stream(int fd_in, bool log_to_stdout)
+{
+	struct probe_stream *s = calloc(1, sizeof(*s));
+	uint8_t *chunk = malloc(READ_CHUNK_SIZE);
+	ssize_t len;
+	int ret;
+	int i;
+
+	if (!s || !chunk) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	s->parser = parser_init();
+	if (!s->parser) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	if (log_to_stdout)
+		parser_log_to_stdout(s->parser);
+	parser_set_writer(s->parser, stream_write, stream_flush, s);
+
+	ret = queue_init(&s->input, INPUT_QUEUE_SIZE);
+	if (ret < 0)
+		goto parser;
+
+	/* pthread_create() returns the error number, errno is not set */
+	ret = -pthread_create(&s->parser_thread, NULL, parser_thread, s);
+	if (ret)
+		goto input;
+
+	for (;;) {
+		len = read(fd_in, chunk, READ_CHUNK_SIZE);
+		if (len < 0 && errno == EINTR)
+			continue;
+		if (len < 0)
+			fprintf(stderr, "error: read failed, error %d\n", errno);
+		if (len <= 0)
+			break;
+
+		/* queue is closed by parser on error */
+		if (!queue_write(&s->input, chunk, len))
+			break;
+	}
+
+	queue_close(&s->input);
+	pthread_join(s->parser_thread, NULL);
+	ret = s->error;
+
+	fprintf(stderr, "input queue high watermark %zu of %zu bytes\n",
+		s->input.max_fill, s->input.size);
+
+	for (i = 0; i < WRITERS_LIMIT; i++)
+		if (s->writers[i].active)
+			writer_stop(&s->writers[i]);
+
+	if (!log_to_stdout)
+		finalize_wave_files(s->parser);
+
+input:
+	queue_free(&s->input);
+parser:
+	parser_free(s->parser);
+out:
+	free(chunk);
+	free(s);
+	return ret;
+}
@@ -0,0 +1,18 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2024 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _PROBES_STREAM_H_
+#define _PROBES_STREAM_H_
+
+#include <stdbool.h>
+
+/*
+ * Parse extraction data from fd until end of stream. Reading, parsing and
+ * writing of each buffer file run in separate threads connected with large
+ * queues, so a slow file write does not stall reading of the probe stream.
+ */
+int parse_stream(int fd_in, bool log_to_stdout);
+
+#endif
@@ -36,6 +36,7 @@ if nargin < 1
 	cfg.snip_edges = true; % must be true
 	cfg.subtract_mean = false; % must be false
 	cfg.use_energy = false;
+	cfg.mel_output = false; % true for log Mel energies output instead of cepstral coefficients
 	cfg.vtln_high = -500.0; % no support
 	cfg.vtln_low = 100.0; % no support
 	cfg.vtln_warp = 1.0; % must be 1.0 (vocal tract length normalization)
@@ -103,6 +104,7 @@ v = cfg.round_to_power_of_two;                   [b8, j] = add_w8b(v, b8, j); %
 v = cfg.snip_edges;                              [b8, j] = add_w8b(v, b8, j); % bool
 v = cfg.subtract_mean;                           [b8, j] = add_w8b(v, b8, j); % bool
 v = cfg.use_energy;                              [b8, j] = add_w8b(v, b8, j); % bool
+v = cfg.mel_output;                              [b8, j] = add_w8b(v, b8, j); % bool
 
 %% Export
 eq_tplg_write(fn, b8, 'DEF_MFCC_PRIV', 'Exported MFCC configuration');
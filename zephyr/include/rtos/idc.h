@@ -32,6 +32,9 @@
 /** \brief IDC send core power down flag. */
 #define IDC_POWER_DOWN		3
 
+/** \brief IDC send flag, completion is collected with idc_wait_msg(). */
+#define IDC_ASYNC		4
+
 /** \brief IDC send timeout in microseconds. */
 #define IDC_TIMEOUT	10000
 
@@ -204,6 +207,8 @@ void idc_init_thread(void);
 
 int idc_send_msg(struct idc_msg *msg, uint32_t mode);
 
+int idc_wait_msg(uint32_t core);
+
 struct idc **idc_get(void);
 
 #endif /* __ZEPHYR_RTOS_IDC_H__ */
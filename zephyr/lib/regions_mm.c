@@ -7,6 +7,7 @@
 
 #include <zephyr/init.h>
 #include <sof/lib/regions_mm.h>
+#include <sof/llext_manager.h>
 
 /* list of vmh_heap objects created */
 static struct list_item vmh_list = LIST_INIT(vmh_list);
@@ -301,11 +302,17 @@ static int vmh_map_region(struct sys_mem_blocks *region, void *ptr, size_t size)
 			return 0;
 	}
 
-	ret = sys_mm_drv_map_region(UINT_TO_POINTER(begin), 0, size, SYS_MM_MEM_PERM_RW);
+	do {
+		ret = sys_mm_drv_map_region(UINT_TO_POINTER(begin), 0, size, SYS_MM_MEM_PERM_RW);
 
-	/* In case of an error, the pages that were successfully mapped must be manually released */
-	if (ret)
-		sys_mm_drv_unmap_region(UINT_TO_POINTER(begin), size);
+		/* In case of an error, the pages that were successfully mapped must be manually
+		 * released
+		 */
+		if (ret)
+			sys_mm_drv_unmap_region(UINT_TO_POINTER(begin), size);
+
+		/* Retry after unmapping an idle library */
+	} while (ret == -ENOMEM && !llext_manager_evict_idle());
 
 	return ret;
 }